@@ -17,7 +17,12 @@ class main_wnd : public app_wnd {
 public:
     main_wnd() : app_wnd("Raster", { WIN_WIDTH,WIN_HEIGHT })
     {
-        paint.connect(this, &main_wnd::on_paint);
+        // Bound at compile time, the cheapest way to get paint.
+        paint_slot.bind<&main_wnd::on_paint>(this);
+        // We clear the background and then blit. No flicker, please.
+        double_buffered=true;
+        // Picture never changes, upload it once.
+        tut_.keep_uploaded(true);
     }
 private:
     // Raster class, converts BGRA to native format.
@@ -25,7 +30,7 @@ private:
 
     bool on_paint(const artist& a) {
         rct client=paint_area;
-        a.fill_rect({ 0,0,0 }, client);
+        a.fill_rect({ 0,0,0,0 }, client);
         a.draw_raster(tut_, 
             { client.w/2-TUT_WIDTH/2,
               client.h/2-TUT_HEIGHT/2
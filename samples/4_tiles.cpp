@@ -0,0 +1,95 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+#include "nice.hpp"
+
+using namespace nice;
+
+// Renders the same display list serially and in tiles, and checks
+// that pixels are the same. Returns 1 if not. Also times both.
+
+#define WIDTH   1024
+#define HEIGHT  768
+#define RUNS    20
+
+// Random paths, strokes, rectangles and lines, like widgets 
+// would draw them. Some are partly outside the target.
+static void record(display_list& dl) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> 
+        x(-50, WIDTH+50), y(-50, HEIGHT+50), d(-80, 80);
+    for (int i=0; i<2000; i++) {
+        color c { (uint8_t)rng(), (uint8_t)rng(), (uint8_t)rng(), (uint8_t)(rng()|0x80) };
+        float cx=x(rng), cy=y(rng);
+        path p;
+        p.move_to(cx+d(rng), cy+d(rng));
+        for (int k=0; k<4; k++) {
+            if (k%2) {
+                float x1=cx+d(rng), y1=cy+d(rng), x2=cx+d(rng), y2=cy+d(rng), 
+                    x3=cx+d(rng), y3=cy+d(rng);
+                p.cubic_to(x1, y1, x2, y2, x3, y3);
+            } else {
+                float x1=cx+d(rng), y1=cy+d(rng);
+                p.line_to(x1, y1);
+            }
+        }
+        p.close();
+        if (i%3==0)
+            dl.stroke_path(c, p, 1+i%5);
+        else
+            dl.fill_path(c, p, i%2 ? fill_rule::even_odd : fill_rule::non_zero);
+        dl.fill_rect(c, { (coord)x(rng), (coord)y(rng), 40, 30 });
+        dl.draw_line(c, { (coord)cx, (coord)cy }, { (coord)(cx+d(rng)), (coord)(cy+d(rng)) });
+    }
+}
+
+// Average milliseconds per call.
+template <typename F> static double time_ms(F f) {
+    auto start=std::chrono::steady_clock::now();
+    for (int i=0; i<RUNS; i++) f();
+    std::chrono::duration<double, std::milli> d=std::chrono::steady_clock::now()-start;
+    return d.count()/RUNS;
+}
+
+// Pixels that differ.
+static size_t compare(const raster& a, const raster& b) {
+    size_t diff=0;
+    auto *pa=(const uint32_t*)a.raw(), *pb=(const uint32_t*)b.raw();
+    for (int i=0; i<a.width()*a.height(); i++)
+        if (pa[i]!=pb[i]) diff++;
+    return diff;
+}
+
+void program()
+{
+    display_list dl;
+    record(dl);
+    tile_renderer tr;
+
+    // Same pixels, everywhere and within damage.
+    raster serial(WIDTH, HEIGHT), tiled(WIDTH, HEIGHT);
+    { artist a(serial); dl.replay(a); }
+    tr.render(dl, tiled);
+    size_t diff=compare(serial, tiled);
+    region damage;
+    damage.add({ 100, 100, 300, 200 });
+    damage.add({ 600, 400, 129, 77 });
+    raster serial_damage(WIDTH, HEIGHT), tiled_damage(WIDTH, HEIGHT);
+    { artist a(serial_damage, damage); dl.replay(a); }
+    uint64_t g=tiled_damage.generation();
+    tr.render(dl, tiled_damage, damage);
+    diff+=compare(serial_damage, tiled_damage);
+    // Only damaged tiles are marked changed, not all of raster.
+    rct changed=tiled_damage.changed_since(g);
+    bool partial=changed.w<WIDTH || changed.h<HEIGHT;
+
+    // Time.
+    double ts=time_ms([&]() { artist a(serial); dl.replay(a); });
+    double tt=time_ms([&]() { tr.render(dl, tiled); });
+
+    std::printf("serial %.2f ms, tiled %.2f ms (%d threads), %zu pixels differ, %s\n",
+        ts, tt, task_pool::shared().threads(), diff, 
+        partial ? "damaged tiles changed" : "all changed");
+    if (diff!=0 || !partial) app::ret_code=1;
+}
@@ -0,0 +1,116 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "nice.hpp"
+
+using namespace nice;
+
+// Emit cost of signals, nanoseconds and allocations per emit. Slots 
+// are member functions that count calls. Baseline is the signal as
+// it was, slots in a map of std::function.
+
+#define EMITS   10000000
+
+// Count allocations.
+static std::atomic<long> allocs_ {0};
+void* operator new(std::size_t n) {
+    allocs_++;
+    if (void* p=std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// Previous signal implementation.
+template <typename... Args>
+class map_signal {
+public:
+    template <typename T> int connect(T* inst, bool (T::* func)(Args...)) {
+        slots_.insert(std::make_pair(++current_id_, [=](Args... args) {
+            return (inst->*func)(args...);
+            }));
+        return current_id_;
+    }
+    void emit(Args... p) {
+        for (auto it = slots_.rbegin(); it != slots_.rend(); ++it) {
+            if (it->second(std::forward<Args>(p)...)) break;
+        }
+    }
+private:
+    std::map<int, std::function<bool(Args...)>> slots_;
+    int current_id_ {0};
+};
+
+class counter {
+public:
+    bool on_motion(const mouse_info& mi) { sum_+=mi.location.x; return false; }
+    bool on_other(const mouse_info& mi) { sum_+=mi.location.y; return false; }
+    long sum() const { return sum_; }
+private:
+    long sum_ {0};
+};
+
+// Nanoseconds per emit, and allocations per emit to allocs.
+template <typename S> static double time_ns(S& s, counter& c, double& allocs) {
+    mouse_info mi { { 1, 2 }, false, false, false, false, false };
+    long allocs_before=allocs_;
+    auto start=std::chrono::steady_clock::now();
+    for (int i=0; i<EMITS; i++) {
+        mi.location.x=i;
+        s.emit(mi);
+    }
+    std::chrono::duration<double, std::nano> d=std::chrono::steady_clock::now()-start;
+    allocs=(double)(allocs_-allocs_before)/EMITS;
+    // Keep the calls.
+    if (c.sum()==0) std::printf(" ");
+    return d.count()/EMITS;
+}
+
+template <typename S> static void run(const char* name, int slots) {
+    counter c;
+    S s;
+    for (int i=0; i<slots; i++)
+        s.connect(&c, i%2 ? &counter::on_other : &counter::on_motion);
+    double allocs, ns=time_ns(s, c, allocs);
+    std::printf("%-14s %d slot(s): %6.2f ns, %.2f allocs\n", name, slots, ns, allocs);
+}
+
+// Static signal, called directly and through one slot of a signal.
+template <auto... Slots> static void run_static() {
+    counter c;
+    static_signal<Slots...> s(&c);
+    int slots=(int)sizeof...(Slots);
+    double allocs, ns=time_ns(s, c, allocs);
+    std::printf("%-14s %d slot(s): %6.2f ns, %.2f allocs\n", "static", slots, ns, allocs);
+    signal<const mouse_info&> dyn;
+    dyn.connect(s);
+    ns=time_ns(dyn, c, allocs);
+    std::printf("%-14s %d slot(s): %6.2f ns, %.2f allocs\n", "signal(static)", slots, ns, allocs);
+}
+
+// Static slot, as windows call it (see wnd::mouse_move_slot).
+template <auto... Slots> static void run_slot() {
+    counter c;
+    static_slot<const mouse_info&> s;
+    s.bind<Slots...>(&c);
+    double allocs, ns=time_ns(s, c, allocs);
+    std::printf("%-14s %d slot(s): %6.2f ns, %.2f allocs\n", "static_slot", 
+        (int)sizeof...(Slots), ns, allocs);
+}
+
+void program()
+{
+    for (int slots : { 1, 4 }) {
+        run<map_signal<const mouse_info&>>("map_signal", slots);
+        run<signal<const mouse_info&>>("signal", slots);
+        run<mt_signal<const mouse_info&>>("mt_signal", slots);
+    }
+    run_static<&counter::on_motion>();
+    run_static<&counter::on_motion, &counter::on_other, 
+        &counter::on_motion, &counter::on_other>();
+    run_slot<&counter::on_motion>();
+    run_slot<&counter::on_motion, &counter::on_other, 
+        &counter::on_motion, &counter::on_other>();
+}
@@ -18,6 +18,9 @@ namespace nice {
     char **app::argv = nullptr;
     bool app::primary_ = false;
     app_instance app::instance_;
+    frame_clock app::frames_;
+    timer_queue app::timers_;
+    post_queue app::posted_;
 
     app_instance app::instance() {
         return instance_;
@@ -30,6 +33,51 @@ namespace nice {
     std::string app::name() {
         return std::filesystem::path(argv[0]).stem().string();
     }
+
+    int app::frame_rate() {
+        return frames_.rate();
+    }
+
+    void app::frame_rate(int fps) {
+        frames_.rate(fps);
+    }
+
+    frame_info app::frame_stats() {
+        return frames_.stats();
+    }
+
+    int app::set_timer(
+        std::chrono::milliseconds interval, 
+        std::function<void()> callback,
+        bool repeat) {
+        return timers_.add(interval, callback, repeat);
+    }
+
+    void app::cancel_timer(int id) {
+        timers_.cancel(id);
+    }
+
+    void app::post(std::function<void()> fn) {
+        if (posted_.push(std::move(fn))) wake();
+    }
+
+    int app::wait_timeout() {
+        if (!frames_.active() && timers_.empty()) return -1;
+        auto deadline = timers_.deadline();
+        if (frames_.active()) deadline = std::min(deadline, frames_.deadline());
+        auto wait = deadline - frame_clock::clock::now();
+        if (wait.count() <= 0) return 0;
+        // Round up, waking early would spin.
+        return (int)std::chrono::ceil<std::chrono::milliseconds>(wait).count();
+    }
+
+    void app::tick() {
+        posted_.awake();
+        std::function<void()> fn;
+        while (posted_.pop(fn)) fn();
+        timers_.tick();
+        frames_.tick();
+    }
 //{{END.DEF}}
 
 }
\ No newline at end of file
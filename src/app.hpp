@@ -42,9 +42,46 @@ namespace nice {
         // Main desktop application loop.
         static void run(const app_wnd& w);
 
+        // Frame rate of the frame signal. 0 is display refresh rate
+        // (X11, SDL and Windows), or 60 when unknown.
+        static int frame_rate();
+        static void frame_rate(int fps);
+
+        // Timing of the last frame.
+        static frame_info frame_stats();
+
+        // Call callback after interval (and every interval if repeat).
+        // Callbacks run on the thread that runs the event loop.
+        static int set_timer(
+            std::chrono::milliseconds interval, 
+            std::function<void()> callback,
+            bool repeat = false);
+        static void cancel_timer(int id);
+
+        // Run fn on the thread that runs the event loop.
+        // Safe to call from any thread.
+        static void post(std::function<void()> fn);
+
     private:
         static bool primary_;
         static app_instance instance_;     
+
+        // Windows subscribe to frame clock.
+        friend class wnd;
+        static frame_clock frames_;
+
+        // Timers.
+        static timer_queue timers_;
+
+        // Work posted from other threads.
+        static post_queue posted_;
+        // Wake up the event loop (native).
+        static void wake();
+
+        // Milliseconds until the loop must wake up (-1 is never).
+        static int wait_timeout();
+        // Run posted work and expired timers, and emit frame if it's time.
+        static void tick();
     };
 //{{END.DEC}}
 }
@@ -0,0 +1,143 @@
+//
+// artist.cpp
+// 
+// Artist draws to native canvas, to a raster or records to a display list.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    artist::~artist() {
+        // Pixels changed. Bump once here rather than per call, many 
+        // artists may draw to one raster at once (i.e. tiles).
+        if (target_ && mark_modified_) target_->modified();
+    }
+
+    void artist::draw_line(color c, pt p1, pt p2) const {
+        if (list_) list_->draw_line(c, p1, p2);
+        else if (target_) 
+            rasterizer::draw_line(surface_of(*target_), rasterizer::pixel(c), p1, p2, clip_);
+        else native_draw_line(c, p1, p2);
+    }
+
+    void artist::draw_rect(color c, rct r) const {
+        if (list_) list_->draw_rect(c, r);
+        else if (target_) 
+            rasterizer::draw_rect(surface_of(*target_), rasterizer::pixel(c), r, clip_);
+        else native_draw_rect(c, r);
+    }
+
+    void artist::fill_rect(color c, rct r) const {
+        if (list_) list_->fill_rect(c, r);
+        else if (target_) 
+            rasterizer::fill_rect(surface_of(*target_), rasterizer::pixel(c), r, clip_);
+        else native_fill_rect(c, r);
+    }
+
+    void artist::draw_raster(const raster& rst, pt p) const {
+        if (list_) list_->draw_raster(rst, p);
+        else if (target_ && rst.premultiplied())
+            rasterizer::blend(surface_of(*target_), surface_of(rst), p, clip_);
+        else if (target_) 
+            rasterizer::blit(surface_of(*target_), surface_of(rst), p, clip_);
+        else native_draw_raster(rst, p);
+    }
+
+    void artist::draw_raster(const raster& rst, rct dst, filter f) const {
+        if (list_) { list_->draw_raster(rst, dst, f); return; }
+        if (region::empty(dst)) return;
+        if (dst.w==rst.width() && dst.h==rst.height()) {
+            draw_raster(rst, { dst.x, dst.y });
+            return;
+        }
+        if (!clip_.empty() && !clip_.intersects(dst)) return;
+        // Bilinear needs reductions under 2x. Box is exact at any size,
+        // mipmaps only keep its footprint small (under 4x).
+        int level=f==filter::nearest ? 0 : rst.mip_level(dst.w, dst.h);
+        if (f==filter::box && level>0) level--;
+        const raster& src=rst.mip(level);
+        if (target_) 
+            rasterizer::scale(surface_of(*target_), surface_of(src), dst, f, 
+                src.premultiplied(), clip_);
+        else native_draw_raster(src, dst, f);
+    }
+
+    void artist::draw_raster_scaled(const raster& rst, rct dst, filter f) const {
+        // Only the visible part.
+        rct vis=region::intersection(dst, native_canvas_bounds());
+        if (!clip_.empty()) vis=region::intersection(vis, clip_.bounds());
+        if (region::empty(vis)) return;
+        raster tmp(vis.w, vis.h);
+        rasterizer::scale(surface_of(tmp), surface_of(rst), 
+            { dst.x-vis.x, dst.y-vis.y, dst.w, dst.h }, f, false, region());
+        tmp.premultiplied(rst.premultiplied());
+        native_draw_temporary(tmp, { vis.x, vis.y });
+    }
+
+    void artist::fill_path(color c, const path& p, fill_rule rule) const {
+        if (list_) list_->fill_path(c, p, rule);
+        else fill_polygons(c, p.flatten(), rule);
+    }
+
+    void artist::stroke_path(color c, const path& p, float width) const {
+        if (list_) list_->stroke_path(c, p, width);
+        else fill_polygons(c, p.stroke(width), fill_rule::non_zero);
+    }
+
+    void artist::draw_text(color c, const font& f, pt p, const std::string& text) const {
+        draw_text(c, text_run::get(f, text), p);
+    }
+
+    void artist::draw_text(color c, const std::shared_ptr<const text_run>& run, pt p) const {
+        if (list_) { list_->draw_text(c, run, p); return; }
+        nice::size e=run->extent();
+        if (!clip_.empty() && !clip_.intersects({ p.x, p.y, e.w, e.h })) return;
+        if (target_) {
+            for (auto const& q : run->quads())
+                rasterizer::fill_mask(surface_of(*target_), rasterizer::pixel(c), 
+                    surface_of(*q.page), q.src, { p.x+q.dst.x, p.y+q.dst.y }, clip_);
+        } 
+        else native_draw_text(c, *run, p);
+    }
+
+    void artist::draw_text_raster(color c, const text_run& run, pt p) const {
+        nice::size e=run.extent();
+        if (e.w<=0 || e.h<=0 || run.quads().empty()) return;
+        raster tmp(e.w, e.h);
+        for (auto const& q : run.quads())
+            rasterizer::fill_mask(surface_of(tmp), rasterizer::pixel(c), 
+                surface_of(*q.page), q.src, q.dst, region());
+        tmp.premultiplied(true);
+        native_draw_temporary(tmp, p);
+    }
+
+    void artist::fill_polygons(color c, const std::vector<polygon>& polys, fill_rule rule,
+        rct bounds) const {
+        if (target_) {
+            rasterizer::fill_polygons(surface_of(*target_), rasterizer::pixel(c), 
+                polys, rule, clip_, bounds);
+            return;
+        }
+        // Canvas. Rasterize to transparent raster and composite it.
+        rct b=region::empty(bounds) ? rasterizer::polygon_bounds(polys) : bounds;
+        b=region::intersection(b, native_canvas_bounds());
+        if (!clip_.empty()) b=region::intersection(b, clip_.bounds());
+        if (region::empty(b)) return;
+        std::vector<polygon> moved=polys;
+        for (auto& poly : moved) 
+            for (auto& p : poly) { p.x-=b.x; p.y-=b.y; }
+        raster tmp(b.w, b.h);
+        rasterizer::fill_polygons(surface_of(tmp), rasterizer::pixel(c), moved, rule, region());
+        // Coverage blended over transparent black is premultiplied.
+        tmp.premultiplied(true);
+        native_draw_temporary(tmp, { b.x, b.y });
+    }
+//{{END.DEF}}
+
+} // namespace nice
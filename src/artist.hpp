@@ -16,20 +16,74 @@
 namespace nice {
 
 //{{BEGIN.DEC}}
+    class display_list; // Forward declaration.
     class artist {
     public:
-        // Pass canvas instance, don't own it.
-        artist(const canvas& canvas) {
+        // Pass canvas instance, don't own it. Clip region tells 
+        // which part of canvas needs painting (empty=all).
+        artist(const canvas& canvas, const region& clip = region()) {
             canvas_ = canvas;
+            clip_ = clip;
         }
+        // Record to display list instead of drawing.
+        artist(display_list& list) : canvas_(), list_(&list) {}
+        // Draw to raster (in software), i.e. on a worker thread. The
+        // raster is marked modified when the artist is destroyed, unless
+        // the caller marks the areas it drew itself (see tile_renderer).
+        artist(raster& target, const region& clip = region(), bool mark_modified = true) 
+            : canvas_(), clip_(clip), target_(&target), mark_modified_(mark_modified) {}
+        ~artist();
+        // Clip region. Skip drawing what doesn't intersect it.
+        const region& clip() const { return clip_; }
         // Methods.
         void draw_line(color c, pt p1, pt p2) const;
         void draw_rect(color c, rct r) const;
         void fill_rect(color c, rct r) const;
         void draw_raster(const raster& rst, pt p) const;
+        // Raster scaled to dst. Reductions over 2x use mipmaps (except
+        // with nearest filter). No default filter, or { x, y } would
+        // be ambiguous.
+        void draw_raster(const raster& rst, rct dst, filter f) const;
+        // Antialiased paths.
+        void fill_path(color c, const path& p, fill_rule rule=fill_rule::non_zero) const;
+        void stroke_path(color c, const path& p, float width=1.0f) const;
+        // Text, p is top left of its first line.
+        void draw_text(color c, const font& f, pt p, const std::string& text) const;
+        // Text laid out before (see text_run::get).
+        void draw_text(color c, const std::shared_ptr<const text_run>& run, pt p) const;
     private:
+        // Drawing to canvas (native).
+        void native_draw_line(color c, pt p1, pt p2) const;
+        void native_draw_rect(color c, rct r) const;
+        void native_fill_rect(color c, rct r) const;
+        void native_draw_raster(const raster& rst, pt p) const;
+        void native_draw_raster(const raster& rst, rct dst, filter f) const;
+        // Drawable area of canvas, temporaries are clipped to it.
+        rct native_canvas_bounds() const;
+        // Raster drawn once (paths, text, scaled rasters). Not cached.
+        void native_draw_temporary(const raster& rst, pt p) const;
+        // Raster scaled in a temporary raster, for canvases that can't.
+        void draw_raster_scaled(const raster& rst, rct dst, filter f) const;
+        void native_draw_text(color c, const text_run& run, pt p) const;
+        // Glyphs tinted in a temporary raster, for canvases that can't.
+        void draw_text_raster(color c, const text_run& run, pt p) const;
         // Passed canvas.
         canvas canvas_;
+        // Clip region.
+        region clip_;
+        // Recording?
+        display_list* list_ {nullptr};
+        // Drawing to raster?
+        raster* target_ {nullptr};
+        bool mark_modified_ {true};
+        // Paths are drawn as polygons, in software. Display lists replay
+        // polygons they cached.
+        friend class display_list;
+        void fill_polygons(color c, const std::vector<polygon>& polys, fill_rule rule,
+            rct bounds={ 0, 0, 0, 0 }) const;
+        static surface surface_of(const raster& r) {
+            return { (uint32_t*)r.raw(), r.width(), r.height(), r.width() };
+        }
     };
 //{{END.DEC}}
 
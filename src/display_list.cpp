@@ -0,0 +1,146 @@
+//
+// display_list.cpp
+// 
+// Display list implementation.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    void display_list::draw_line(color c, pt p1, pt p2) {
+        commands_.push_back({ op::line, c, { p1.x, p1.y, p2.x, p2.y }, nullptr });
+    }
+
+    void display_list::draw_rect(color c, rct r) {
+        commands_.push_back({ op::rect, c, r, nullptr });
+    }
+
+    void display_list::fill_rect(color c, rct r) {
+        commands_.push_back({ op::fill, c, r, nullptr });
+    }
+
+    void display_list::draw_raster(const raster& rst, pt p) {
+        commands_.push_back({ op::raster, {}, { p.x, p.y, rst.width(), rst.height() }, 
+            &rst, rst.id(), rst.generation() });
+    }
+
+    void display_list::draw_raster(const raster& rst, rct dst, filter f) {
+        command cmd { op::scaled, {}, dst, &rst, rst.id(), rst.generation() };
+        cmd.flt=f;
+        commands_.push_back(cmd);
+    }
+
+    void display_list::fill_path(color c, const path& p, fill_rule rule) {
+        commands_.push_back({ op::fill_path, c, p.bounds(), nullptr, 0, 0,
+            std::make_shared<const path>(p), 0, rule });
+    }
+
+    void display_list::stroke_path(color c, const path& p, float width) {
+        // Stroke reaches half width out, plus antialiasing.
+        rct b=p.bounds();
+        coord e=(coord)std::ceil(width/2)+1;
+        commands_.push_back({ op::stroke_path, c, { b.x-e, b.y-e, b.w+2*e, b.h+2*e }, 
+            nullptr, 0, 0, std::make_shared<const path>(p), width });
+    }
+
+    void display_list::draw_text(color c, const std::shared_ptr<const text_run>& run, pt p) {
+        nice::size e=run->extent();
+        command cmd { op::text, c, { p.x, p.y, e.w, e.h }, nullptr };
+        cmd.run=run;
+        commands_.push_back(cmd);
+    }
+
+    void display_list::replay(const artist& a) const {
+        for (auto const& cmd : commands_) replay(a, cmd);
+    }
+
+    void display_list::replay(const artist& a, std::span<const uint32_t> which) const {
+        for (auto i : which) replay(a, commands_[i]);
+    }
+
+    void display_list::replay(const artist& a, const command& cmd) {
+        switch (cmd.o) {
+        case op::line:
+            a.draw_line(cmd.c, { cmd.r.x, cmd.r.y }, { cmd.r.w, cmd.r.h });
+            break;
+        case op::rect:
+            a.draw_rect(cmd.c, cmd.r);
+            break;
+        case op::fill:
+            a.fill_rect(cmd.c, cmd.r);
+            break;
+        case op::raster:
+            assert(cmd.rst->id()==cmd.id); // Raster outlived the list?
+            a.draw_raster(*cmd.rst, { cmd.r.x, cmd.r.y });
+            break;
+        case op::scaled:
+            assert(cmd.rst->id()==cmd.id);
+            a.draw_raster(*cmd.rst, cmd.r, cmd.flt);
+            break;
+        case op::fill_path:
+            if (cmd.polys && !a.list_) a.fill_polygons(cmd.c, *cmd.polys, cmd.rule, cmd.pb);
+            else a.fill_path(cmd.c, *cmd.pth, cmd.rule);
+            break;
+        case op::stroke_path:
+            if (cmd.polys && !a.list_) 
+                a.fill_polygons(cmd.c, *cmd.polys, fill_rule::non_zero, cmd.pb);
+            else a.stroke_path(cmd.c, *cmd.pth, cmd.width);
+            break;
+        case op::text:
+            a.draw_text(cmd.c, cmd.run, { cmd.r.x, cmd.r.y });
+            break;
+        }
+    }
+
+    region display_list::diff(const display_list& prev) const {
+        // Skip common head and tail, what remains in between 
+        // changed in both lists.
+        size_t n=commands_.size(), m=prev.commands_.size(), head=0, tail=0;
+        while (head<n && head<m && same(commands_[head], prev.commands_[head])) 
+            head++;
+        while (tail<n-head && tail<m-head 
+            && same(commands_[n-1-tail], prev.commands_[m-1-tail])) 
+            tail++;
+        region damage;
+        for (size_t i=head; i<n-tail; i++) damage.add(bounds(commands_[i]));
+        for (size_t i=head; i<m-tail; i++) damage.add(bounds(prev.commands_[i]));
+        return damage;
+    }
+
+    void display_list::flatten() const {
+        for (auto const& cmd : commands_) {
+            if (cmd.polys || (cmd.o!=op::fill_path && cmd.o!=op::stroke_path)) 
+                continue;
+            auto polys=std::make_shared<std::vector<polygon>>(cmd.o==op::fill_path 
+                ? cmd.pth->flatten() : cmd.pth->stroke(cmd.width));
+            cmd.pb=rasterizer::polygon_bounds(*polys);
+            cmd.polys=polys;
+        }
+    }
+
+    rct display_list::bounds(const command& cmd) {
+        if (cmd.polys) return cmd.pb;
+        // Antialiased fill reaches into the pixel after its bounds.
+        if (cmd.o==op::fill_path) return { cmd.r.x, cmd.r.y, cmd.r.w+1, cmd.r.h+1 };
+        if (cmd.o!=op::line) return cmd.r;
+        coord x=std::min(cmd.r.x, cmd.r.w), y=std::min(cmd.r.y, cmd.r.h);
+        return { x, y, 
+            std::max(cmd.r.x, cmd.r.w) - x + 1, std::max(cmd.r.y, cmd.r.h) - y + 1 };
+    }
+
+    bool display_list::same(const command& a, const command& b) {
+        return a.o==b.o && a.id==b.id && a.gen==b.gen
+            && a.c.r==b.c.r && a.c.g==b.c.g && a.c.b==b.c.b && a.c.a==b.c.a
+            && a.r.x==b.r.x && a.r.y==b.r.y && a.r.w==b.r.w && a.r.h==b.r.h
+            && a.width==b.width && a.rule==b.rule && a.run==b.run && a.flt==b.flt
+            && (a.pth==b.pth || (a.pth && b.pth && *a.pth==*b.pth));
+    }
+//{{END.DEF}}
+
+} // namespace nice
@@ -0,0 +1,77 @@
+//
+// display_list.hpp
+// 
+// Recorded artist commands. A display list can be replayed to
+// any artist, and compared to another (i.e. previous frame) to
+// find the area that changed.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _DISPLAY_LIST_HPP
+#define _DISPLAY_LIST_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    class artist; // Forward declaration.
+    class display_list {
+    public:
+        // Remove all commands (but keep memory for next recording).
+        void clear() { commands_.clear(); }
+        bool empty() const { return commands_.empty(); }
+        size_t size() const { return commands_.size(); }
+        // Record commands.
+        void draw_line(color c, pt p1, pt p2);
+        void draw_rect(color c, rct r);
+        void fill_rect(color c, rct r);
+        // Rasters are referenced, not copied, and must outlive the list.
+        void draw_raster(const raster& rst, pt p);
+        void draw_raster(const raster& rst, rct dst, filter f);
+        // Paths are copied.
+        void fill_path(color c, const path& p, fill_rule rule);
+        void stroke_path(color c, const path& p, float width);
+        void draw_text(color c, const std::shared_ptr<const text_run>& run, pt p);
+        // Draw all commands with artist.
+        void replay(const artist& a) const;
+        // Draw selected commands (indices, in order) with artist.
+        void replay(const artist& a, std::span<const uint32_t> which) const;
+        // Area touched by command i.
+        rct bounds(size_t i) const { return bounds(commands_[i]); }
+        // Flatten and stroke paths once. Replays then draw the cached 
+        // polygons, and bounds are those of the polygons. Call before 
+        // replaying parts of the list many times (i.e. per tile).
+        void flatten() const;
+        // Area where this list draws differently than prev. Rasters 
+        // are compared by id, position and generation of pixels when
+        // recorded, so a new raster at a freed one's address differs.
+        region diff(const display_list& prev) const;
+    private:
+        enum class op : uint8_t { line, rect, fill, raster, scaled, fill_path, stroke_path, text };
+        struct command {
+            op o;
+            color c;
+            rct r; // Line is from (x,y) to (w,h), path has its bounds here.
+            const raster* rst;
+            uint64_t id {0}, gen {0}; // Raster id and generation.
+            std::shared_ptr<const path> pth {};
+            float width {0};
+            fill_rule rule {fill_rule::non_zero};
+            std::shared_ptr<const text_run> run {};
+            filter flt {filter::bilinear};
+            // Cached polygons of a path, and their bounds.
+            mutable std::shared_ptr<const std::vector<polygon>> polys {};
+            mutable rct pb {0, 0, 0, 0};
+        };
+        static rct bounds(const command& cmd);
+        static void replay(const artist& a, const command& cmd);
+        static bool same(const command& a, const command& b);
+        std::vector<command> commands_;
+    };
+//{{END.DEC}}
+
+} // namespace nice
+
+#endif // _DISPLAY_LIST_HPP
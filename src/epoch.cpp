@@ -0,0 +1,90 @@
+//
+// epoch.cpp
+//
+// Epoch based reclamation implementation.
+//
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+//
+// 16.10.2026   tstih
+//
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    // Static variables.
+    std::atomic<uint64_t> epoch::global_ { 0 };
+    std::atomic<epoch::record*> epoch::records_ { nullptr };
+    epoch::retired_list epoch::retired_;
+
+    epoch::record& epoch::local() {
+        // Records are never freed, thread exit hands them to the next thread.
+        struct owner {
+            record* r;
+            owner() {
+                for (r=records_.load(std::memory_order_acquire); r!=nullptr; r=r->next) {
+                    bool unused=false;
+                    if (r->used.compare_exchange_strong(unused, true)) return;
+                }
+                r=new record;
+                r->next=records_.load(std::memory_order_relaxed);
+                while (!records_.compare_exchange_weak(r->next, r,
+                    std::memory_order_release, std::memory_order_relaxed));
+            }
+            ~owner() { r->used.store(false, std::memory_order_release); }
+        };
+        thread_local owner o;
+        return *o.r;
+    }
+
+    epoch::guard::guard() {
+        record& r=local();
+        if (r.depth++>0) return;
+        // Acquire, objects unlinked before the epoch we enter are gone.
+        // Release, reads of the previous section happen before it.
+        r.active.store(global_.load(std::memory_order_acquire)+1, std::memory_order_release);
+        // Writers must see the epoch before we load what they publish.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    epoch::guard::~guard() {
+        record& r=local();
+        if (--r.depth==0) r.active.store(0, std::memory_order_release);
+    }
+
+    void epoch::retire(std::function<void()> del) {
+        // Readers that enter after the increment can't see the object.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint64_t e=global_.fetch_add(1, std::memory_order_seq_cst);
+        {
+            std::lock_guard<std::mutex> lock(retired_.mutex);
+            retired_.v.emplace_back(e, std::move(del));
+        }
+        collect();
+    }
+
+    void epoch::collect() {
+        std::vector<std::function<void()>> ready;
+        {
+            // Scan under the lock, so everything retired is unlinked 
+            // before readers are looked at.
+            std::lock_guard<std::mutex> lock(retired_.mutex);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            // Oldest epoch a reader is in.
+            uint64_t oldest=UINT64_MAX;
+            for (record* r=records_.load(std::memory_order_acquire); r!=nullptr; r=r->next) {
+                uint64_t a=r->active.load(std::memory_order_acquire);
+                if (a!=0) oldest=std::min(oldest, a-1);
+            }
+            auto it=std::partition(retired_.v.begin(), retired_.v.end(),
+                [oldest](const auto& p) { return p.first>=oldest; });
+            for (auto i=it; i!=retired_.v.end(); ++i) ready.push_back(std::move(i->second));
+            retired_.v.erase(it, retired_.v.end());
+        }
+        // Delete outside the lock, deleters may retire more.
+        for (auto& del : ready) del();
+    }
+//{{END.DEF}}
+
+} // namespace nice
@@ -0,0 +1,59 @@
+//
+// epoch.hpp
+//
+// Epoch based reclamation. Readers enter a section with a guard,
+// which writes only to their own thread's record, and may use
+// any shared object they load inside it. Writers unlink an object
+// and retire it; it is deleted once no reader can still see it.
+//
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+//
+// 16.10.2026   tstih
+//
+#ifndef _EPOCH_HPP
+#define _EPOCH_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    class epoch {
+    public:
+        // Reader section, can be nested.
+        class guard {
+        public:
+            guard();
+            ~guard();
+            guard(const guard&) = delete;
+            guard& operator=(const guard&) = delete;
+        };
+        // Call del when readers that might have loaded the object
+        // before it was unlinked have left. Retired in a guard (i.e.
+        // from a slot), it waits for a later retire.
+        static void retire(std::function<void()> del);
+    private:
+        // One per thread, reused after the thread exits.
+        struct alignas(64) record {
+            std::atomic<uint64_t> active { 0 }; // Epoch+1 in a section, else 0.
+            std::atomic<bool> used { true };
+            int depth { 0 };
+            record* next { nullptr };
+        };
+        static record& local();
+        static void collect();
+        static std::atomic<uint64_t> global_;
+        static std::atomic<record*> records_;
+        // Retired objects and their epochs. Those left at exit are 
+        // deleted then, no reader is running anymore.
+        struct retired_list {
+            std::mutex mutex;
+            std::vector<std::pair<uint64_t, std::function<void()>>> v;
+            ~retired_list() { for (auto& p : v) p.second(); }
+        };
+        static retired_list retired_;
+    };
+//{{END.DEC}}
+
+} // namespace nice
+
+#endif // _EPOCH_HPP
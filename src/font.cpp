@@ -0,0 +1,269 @@
+//
+// font.cpp
+// 
+// Font implementation. The embedded font is font8x8 (public domain,
+// after IBM PC BIOS), one byte per row, lowest bit is leftmost pixel.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    // ASCII 0x20-0x7e.
+    static const uint8_t font8x8[95][8] = {
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // space
+        { 0x18, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18, 0x00 }, // !
+        { 0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // "
+        { 0x36, 0x36, 0x7F, 0x36, 0x7F, 0x36, 0x36, 0x00 }, // #
+        { 0x0C, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x0C, 0x00 }, // $
+        { 0x00, 0x63, 0x33, 0x18, 0x0C, 0x66, 0x63, 0x00 }, // %
+        { 0x1C, 0x36, 0x1C, 0x6E, 0x3B, 0x33, 0x6E, 0x00 }, // &
+        { 0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '
+        { 0x18, 0x0C, 0x06, 0x06, 0x06, 0x0C, 0x18, 0x00 }, // (
+        { 0x06, 0x0C, 0x18, 0x18, 0x18, 0x0C, 0x06, 0x00 }, // )
+        { 0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00 }, // *
+        { 0x00, 0x0C, 0x0C, 0x3F, 0x0C, 0x0C, 0x00, 0x00 }, // +
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x06 }, // ,
+        { 0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00 }, // -
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00 }, // .
+        { 0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x00 }, // /
+        { 0x3E, 0x63, 0x73, 0x7B, 0x6F, 0x67, 0x3E, 0x00 }, // 0
+        { 0x0C, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x00 }, // 1
+        { 0x1E, 0x33, 0x30, 0x1C, 0x06, 0x33, 0x3F, 0x00 }, // 2
+        { 0x1E, 0x33, 0x30, 0x1C, 0x30, 0x33, 0x1E, 0x00 }, // 3
+        { 0x38, 0x3C, 0x36, 0x33, 0x7F, 0x30, 0x78, 0x00 }, // 4
+        { 0x3F, 0x03, 0x1F, 0x30, 0x30, 0x33, 0x1E, 0x00 }, // 5
+        { 0x1C, 0x06, 0x03, 0x1F, 0x33, 0x33, 0x1E, 0x00 }, // 6
+        { 0x3F, 0x33, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x00 }, // 7
+        { 0x1E, 0x33, 0x33, 0x1E, 0x33, 0x33, 0x1E, 0x00 }, // 8
+        { 0x1E, 0x33, 0x33, 0x3E, 0x30, 0x18, 0x0E, 0x00 }, // 9
+        { 0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x00 }, // :
+        { 0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x06 }, // ;
+        { 0x18, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x18, 0x00 }, // <
+        { 0x00, 0x00, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00 }, // =
+        { 0x06, 0x0C, 0x18, 0x30, 0x18, 0x0C, 0x06, 0x00 }, // >
+        { 0x1E, 0x33, 0x30, 0x18, 0x0C, 0x00, 0x0C, 0x00 }, // ?
+        { 0x3E, 0x63, 0x7B, 0x7B, 0x7B, 0x03, 0x1E, 0x00 }, // @
+        { 0x0C, 0x1E, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x00 }, // A
+        { 0x3F, 0x66, 0x66, 0x3E, 0x66, 0x66, 0x3F, 0x00 }, // B
+        { 0x3C, 0x66, 0x03, 0x03, 0x03, 0x66, 0x3C, 0x00 }, // C
+        { 0x1F, 0x36, 0x66, 0x66, 0x66, 0x36, 0x1F, 0x00 }, // D
+        { 0x7F, 0x46, 0x16, 0x1E, 0x16, 0x46, 0x7F, 0x00 }, // E
+        { 0x7F, 0x46, 0x16, 0x1E, 0x16, 0x06, 0x0F, 0x00 }, // F
+        { 0x3C, 0x66, 0x03, 0x03, 0x73, 0x66, 0x7C, 0x00 }, // G
+        { 0x33, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x33, 0x00 }, // H
+        { 0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 }, // I
+        { 0x78, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E, 0x00 }, // J
+        { 0x67, 0x66, 0x36, 0x1E, 0x36, 0x66, 0x67, 0x00 }, // K
+        { 0x0F, 0x06, 0x06, 0x06, 0x46, 0x66, 0x7F, 0x00 }, // L
+        { 0x63, 0x77, 0x7F, 0x7F, 0x6B, 0x63, 0x63, 0x00 }, // M
+        { 0x63, 0x67, 0x6F, 0x7B, 0x73, 0x63, 0x63, 0x00 }, // N
+        { 0x1C, 0x36, 0x63, 0x63, 0x63, 0x36, 0x1C, 0x00 }, // O
+        { 0x3F, 0x66, 0x66, 0x3E, 0x06, 0x06, 0x0F, 0x00 }, // P
+        { 0x1E, 0x33, 0x33, 0x33, 0x3B, 0x1E, 0x38, 0x00 }, // Q
+        { 0x3F, 0x66, 0x66, 0x3E, 0x36, 0x66, 0x67, 0x00 }, // R
+        { 0x1E, 0x33, 0x07, 0x0E, 0x38, 0x33, 0x1E, 0x00 }, // S
+        { 0x3F, 0x2D, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 }, // T
+        { 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x00 }, // U
+        { 0x33, 0x33, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00 }, // V
+        { 0x63, 0x63, 0x63, 0x6B, 0x7F, 0x77, 0x63, 0x00 }, // W
+        { 0x63, 0x63, 0x36, 0x1C, 0x1C, 0x36, 0x63, 0x00 }, // X
+        { 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x0C, 0x1E, 0x00 }, // Y
+        { 0x7F, 0x63, 0x31, 0x18, 0x4C, 0x66, 0x7F, 0x00 }, // Z
+        { 0x1E, 0x06, 0x06, 0x06, 0x06, 0x06, 0x1E, 0x00 }, // [
+        { 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x40, 0x00 }, // backslash
+        { 0x1E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x1E, 0x00 }, // ]
+        { 0x08, 0x1C, 0x36, 0x63, 0x00, 0x00, 0x00, 0x00 }, // ^
+        { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF }, // _
+        { 0x0C, 0x0C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00 }, // `
+        { 0x00, 0x00, 0x1E, 0x30, 0x3E, 0x33, 0x6E, 0x00 }, // a
+        { 0x07, 0x06, 0x06, 0x3E, 0x66, 0x66, 0x3B, 0x00 }, // b
+        { 0x00, 0x00, 0x1E, 0x33, 0x03, 0x33, 0x1E, 0x00 }, // c
+        { 0x38, 0x30, 0x30, 0x3E, 0x33, 0x33, 0x6E, 0x00 }, // d
+        { 0x00, 0x00, 0x1E, 0x33, 0x3F, 0x03, 0x1E, 0x00 }, // e
+        { 0x1C, 0x36, 0x06, 0x0F, 0x06, 0x06, 0x0F, 0x00 }, // f
+        { 0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x1F }, // g
+        { 0x07, 0x06, 0x36, 0x6E, 0x66, 0x66, 0x67, 0x00 }, // h
+        { 0x0C, 0x00, 0x0E, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 }, // i
+        { 0x30, 0x00, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E }, // j
+        { 0x07, 0x06, 0x66, 0x36, 0x1E, 0x36, 0x67, 0x00 }, // k
+        { 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00 }, // l
+        { 0x00, 0x00, 0x33, 0x7F, 0x7F, 0x6B, 0x63, 0x00 }, // m
+        { 0x00, 0x00, 0x1F, 0x33, 0x33, 0x33, 0x33, 0x00 }, // n
+        { 0x00, 0x00, 0x1E, 0x33, 0x33, 0x33, 0x1E, 0x00 }, // o
+        { 0x00, 0x00, 0x3B, 0x66, 0x66, 0x3E, 0x06, 0x0F }, // p
+        { 0x00, 0x00, 0x6E, 0x33, 0x33, 0x3E, 0x30, 0x78 }, // q
+        { 0x00, 0x00, 0x3B, 0x6E, 0x66, 0x06, 0x0F, 0x00 }, // r
+        { 0x00, 0x00, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x00 }, // s
+        { 0x08, 0x0C, 0x3E, 0x0C, 0x0C, 0x2C, 0x18, 0x00 }, // t
+        { 0x00, 0x00, 0x33, 0x33, 0x33, 0x33, 0x6E, 0x00 }, // u
+        { 0x00, 0x00, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00 }, // v
+        { 0x00, 0x00, 0x63, 0x6B, 0x7F, 0x7F, 0x36, 0x00 }, // w
+        { 0x00, 0x00, 0x63, 0x36, 0x1C, 0x36, 0x63, 0x00 }, // x
+        { 0x00, 0x00, 0x33, 0x33, 0x33, 0x3E, 0x30, 0x1F }, // y
+        { 0x00, 0x00, 0x3F, 0x19, 0x0C, 0x26, 0x3F, 0x00 }, // z
+        { 0x38, 0x0C, 0x0C, 0x07, 0x0C, 0x0C, 0x38, 0x00 }, // {
+        { 0x18, 0x18, 0x18, 0x00, 0x18, 0x18, 0x18, 0x00 }, // |
+        { 0x07, 0x0C, 0x0C, 0x38, 0x0C, 0x0C, 0x07, 0x00 }, // }
+        { 0x6E, 0x3B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }  // ~
+    };
+
+#ifdef __FREETYPE__
+    // One library for all faces. Opening and closing faces on it 
+    // is not thread safe.
+    static std::mutex ft_mutex;
+    static FT_Library ft_library() {
+        static FT_Library lib=[] {
+            FT_Library l=nullptr;
+            if (::FT_Init_FreeType(&l)!=0) 
+                throw_ex(nice_exception, "Unable to initialize FreeType.");
+            return l;
+        }();
+        return lib;
+    }
+#endif
+
+    struct font::face_s {
+        ~face_s() {
+#ifdef __FREETYPE__
+            std::lock_guard<std::mutex> lock(ft_mutex);
+            if (ft!=nullptr) ::FT_Done_Face(ft);
+#endif
+        }
+        // Glyph of codepoint, rasterized on first use. Call locked.
+        const glyph& get(uint32_t cp) {
+            auto it=glyphs.find(cp);
+            if (it!=glyphs.end()) return it->second;
+            glyph g { nullptr, { 0, 0, 0, 0 }, 0, 0, 0 };
+#ifdef __FREETYPE__
+            if (ft!=nullptr) {
+                if (::FT_Load_Char(ft, cp, FT_LOAD_RENDER)==0) {
+                    FT_GlyphSlot slot=ft->glyph;
+                    FT_Bitmap& bm=slot->bitmap;
+                    g.left=slot->bitmap_left;
+                    g.top=ascent-slot->bitmap_top;
+                    g.advance=(int)((slot->advance.x+32)>>6);
+                    if (bm.width>0 && bm.rows>0 && bm.pixel_mode==FT_PIXEL_MODE_GRAY) {
+                        // Negative pitch stores rows bottom up.
+                        const uint8_t* top=bm.buffer - (bm.pitch<0 ? (bm.rows-1)*bm.pitch : 0);
+                        g.page=atlas.insert(bm.width, bm.rows, top, bm.pitch, g.src);
+                    }
+                }
+                return glyphs[cp]=g;
+            }
+#endif
+            // Embedded font, missing glyphs are question marks.
+            uint32_t c=(cp<0x20 || cp>0x7e) ? '?' : cp;
+            g.advance=8*scale;
+            if (c!=' ') {
+                int n=8*scale;
+                std::vector<uint8_t> alpha(n*n);
+                for (int y=0; y<n; y++)
+                    for (int x=0; x<n; x++)
+                        alpha[y*n+x]=(font8x8[c-0x20][y/scale]>>(x/scale)) & 1 ? 0xff : 0;
+                g.page=atlas.insert(n, n, alpha.data(), n, g.src);
+            }
+            return glyphs[cp]=g;
+        }
+        // Pen adjustment between two codepoints.
+        int kerning([[maybe_unused]] uint32_t prev, [[maybe_unused]] uint32_t cp) {
+#ifdef __FREETYPE__
+            if (ft!=nullptr && prev!=0 && FT_HAS_KERNING(ft)) {
+                FT_Vector k;
+                if (::FT_Get_Kerning(ft, ::FT_Get_Char_Index(ft, prev), 
+                    ::FT_Get_Char_Index(ft, cp), FT_KERNING_DEFAULT, &k)==0)
+                    return (int)((k.x+32)>>6);
+            }
+#endif
+            return 0;
+        }
+        int size, height, ascent, scale;
+        uint64_t id;
+#ifdef __FREETYPE__
+        FT_Face ft {nullptr};
+#endif
+        std::mutex m;
+        glyph_atlas atlas;
+        std::unordered_map<uint32_t, glyph> glyphs;
+    };
+
+    static uint64_t next_font_id() {
+        static std::atomic<uint64_t> id {0};
+        return ++id;
+    }
+
+    font::font(int size) {
+        face_=std::make_shared<face_s>();
+        face_->id=next_font_id();
+        face_->size=size;
+        face_->scale=std::max(1, (size+4)/8);
+        face_->height=8*face_->scale;
+        face_->ascent=7*face_->scale;
+    }
+
+    font::font([[maybe_unused]] const std::string& file, int size) : font(size) {
+#ifdef __FREETYPE__
+        FT_Face ft=nullptr;
+        {
+            std::lock_guard<std::mutex> lock(ft_mutex);
+            if (::FT_New_Face(ft_library(), file.c_str(), 0, &ft)!=0)
+                throw_ex(nice_exception, "Unable to load font.");
+        }
+        face_->ft=ft;
+        ::FT_Set_Pixel_Sizes(ft, 0, size);
+        auto const& m=ft->size->metrics;
+        face_->ascent=(int)((m.ascender+63)>>6);
+        face_->height=(int)((m.height+63)>>6);
+#endif
+    }
+
+    int font::size() const { return face_->size; }
+    int font::height() const { return face_->height; }
+    int font::ascent() const { return face_->ascent; }
+    uint64_t font::id() const { return face_->id; }
+
+    nice::size font::measure(const std::string& text) const {
+        return text_run::get(*this, text)->extent();
+    }
+
+    // Next codepoint of UTF-8 text, U+FFFD for invalid bytes.
+    static uint32_t utf8_next(const std::string& s, size_t& i) {
+        uint8_t b=s[i++];
+        if (b<0x80) return b;
+        int n=(b>=0xf0) ? 3 : (b>=0xe0) ? 2 : (b>=0xc0) ? 1 : -1;
+        if (n<0) return 0xfffd;
+        uint32_t cp=b & (0x3f>>n);
+        for (int k=0; k<n; k++) {
+            if (i>=s.size() || (s[i] & 0xc0)!=0x80) return 0xfffd;
+            cp=(cp<<6) | (s[i++] & 0x3f);
+        }
+        return cp;
+    }
+
+    nice::size font::layout(const std::string& text, std::vector<glyph_quad>& quads) const {
+        std::lock_guard<std::mutex> lock(face_->m);
+        int x=0, y=0, w=0;
+        uint32_t prev=0;
+        for (size_t i=0; i<text.size(); ) {
+            uint32_t cp=utf8_next(text, i);
+            if (cp=='\n') {
+                w=std::max(w, x);
+                x=0; y+=face_->height; prev=0;
+                continue;
+            }
+            x+=face_->kerning(prev, cp);
+            prev=cp;
+            const glyph& g=face_->get(cp);
+            if (g.page!=nullptr) quads.push_back({ g.page, g.src, { x+g.left, y+g.top } });
+            x+=g.advance;
+        }
+        return { std::max(w, x), y+face_->height };
+    }
+//{{END.DEF}}
+
+} // namespace nice
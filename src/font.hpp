@@ -0,0 +1,62 @@
+//
+// font.hpp
+// 
+// Fonts. Glyphs are rasterized on first use (with FreeType, or from
+// the embedded 8x8 bitmap font) and packed into the font's atlas.
+//
+//   nice::font f("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf", 14);
+//   a.draw_text({ 0, 0, 0 }, f, { 10, 10 }, "Hello!");
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _FONT_HPP
+#define _FONT_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    // Glyph metrics and its pixels in the atlas.
+    typedef struct glyph_s {
+        const raster* page; // Atlas page, nullptr for blanks.
+        rct src;            // Pixels in page.
+        int left, top;      // Offset from pen, top is from top of line.
+        int advance;
+    } glyph;
+
+    // Glyph placed in laid out text.
+    typedef struct glyph_quad_s {
+        const raster* page;
+        rct src;
+        pt dst;             // From top left of text.
+    } glyph_quad;
+
+    class font {
+    public:
+        // Embedded 8x8 bitmap font (ASCII), scaled by whole pixels to size.
+        font(int size=8);
+        // Font file. Needs FreeType (build with __FREETYPE__), without 
+        // it the embedded font is used.
+        font(const std::string& file, int size);
+        // Requested size, line height and baseline (from top of line).
+        int size() const;
+        int height() const;
+        int ascent() const;
+        // Unique font id.
+        uint64_t id() const;
+        // Extent of text drawn in this font.
+        nice::size measure(const std::string& text) const;
+        // Place glyphs of text (UTF-8, lines split by \n). Rasterizes 
+        // missing glyphs. Thread safe, use text_run to get it cached.
+        nice::size layout(const std::string& text, std::vector<glyph_quad>& quads) const;
+    private:
+        struct face_s;
+        std::shared_ptr<face_s> face_;
+    };
+//{{END.DEC}}
+
+} // namespace nice
+
+#endif // _FONT_HPP
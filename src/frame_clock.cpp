@@ -0,0 +1,65 @@
+//
+// frame_clock.cpp
+// 
+// Frame clock implementation.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+//{{BEGIN.DEF}}
+    frame_clock::clock::duration frame_clock::period() const {
+        return std::chrono::duration_cast<clock::duration>(
+            std::chrono::seconds(1)) / (rate_ > 0 ? rate_ : 60);
+    }
+
+    void frame_clock::add(wnd* w) {
+        if (std::find(wnds_.begin(), wnds_.end(), w)!=wnds_.end()) return;
+        // First window starts the clock. Restarted, it stays on its
+        // grid, so moves queued by an idle window still wait for the 
+        // next frame, and the idle time isn't counted as a frame.
+        if (wnds_.empty()) {
+            auto now=clock::now();
+            if (stats_.frame==0) 
+                deadline_=now;
+            else if (deadline_ < now)
+                deadline_ += ((now - deadline_) / period() + 1) * period();
+            last_=deadline_ - period();
+        }
+        wnds_.push_back(w);
+    }
+
+    void frame_clock::remove(wnd* w) {
+        wnds_.erase(std::remove(wnds_.begin(), wnds_.end(), w), wnds_.end());
+    }
+
+    void frame_clock::tick(clock::time_point now) {
+        if (!active() || now < deadline_) return;
+        // Statistics.
+        stats_.delta = stats_.frame==0 ? period() : now - last_;
+        stats_.frame++;
+        total_ += stats_.delta;
+        stats_.mean = total_ / stats_.frame;
+        stats_.worst = std::max(stats_.worst, stats_.delta);
+        last_ = now;
+        // Next deadline on the grid. Skip the ones we missed.
+        deadline_ += period();
+        if (deadline_ <= now) {
+            auto behind = (now - deadline_) / period() + 1;
+            stats_.missed += behind;
+            deadline_ += behind * period();
+        }
+        // Handlers can remove windows. Mouse moves first, so that
+        // frame handlers see the latest position.
+        auto wnds=wnds_;
+        for (auto w : wnds) {
+            w->flush_motion();
+            w->frame.emit(stats_);
+        }
+    }
+//{{END.DEF}}
+}
@@ -0,0 +1,54 @@
+//
+// frame_clock.hpp
+// 
+// Frame clock. Emits frame signal to subscribed windows at a
+// fixed rate, and delivers their compressed mouse moves. 
+// Deadlines are on a fixed grid (start + n * period), so frames 
+// don't drift, and late frames are skipped, not queued. Event 
+// loops sleep until the next deadline.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _FRAME_CLOCK_HPP
+#define _FRAME_CLOCK_HPP
+
+#include "includes.hpp"
+#include "frame_info.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    class frame_clock {
+    public:
+        typedef std::chrono::steady_clock clock;
+        // Frames per second. 0 means display refresh rate (backends
+        // that can query it set it at startup), or 60.
+        int rate() const { return rate_; }
+        void rate(int fps) { rate_=fps; }
+        // Windows receiving frames.
+        void add(wnd* w);
+        void remove(wnd* w);
+        // Any windows?
+        bool active() const { return !wnds_.empty(); }
+        // Next frame deadline.
+        clock::time_point deadline() const { return deadline_; }
+        // Emit frame to all windows when deadline is reached.
+        void tick(clock::time_point now = clock::now());
+        // Timing of the last frame.
+        const frame_info& stats() const { return stats_; }
+    private:
+        clock::duration period() const;
+        int rate_ {0};
+        std::vector<wnd*> wnds_;
+        clock::time_point deadline_, last_;
+        std::chrono::nanoseconds total_ {0};
+        frame_info stats_ {};
+    };
+//{{END.DEC}}
+
+}
+
+#endif // _FRAME_CLOCK_HPP
@@ -0,0 +1,28 @@
+//
+// frame_info.hpp
+// 
+// The structure for frame signal. Frame number and frame timing.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _FRAME_INFO_HPP
+#define _FRAME_INFO_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    struct frame_info {
+        uint64_t frame;                     // Frame number (from 1).
+        std::chrono::nanoseconds delta;     // Time since previous frame.
+        std::chrono::nanoseconds mean;      // Average frame time.
+        std::chrono::nanoseconds worst;     // Longest frame time.
+        uint64_t missed;                    // Skipped frame deadlines.
+    };
+//{{END.DEC}}
+
+}
+
+#endif // _FRAME_INFO_HPP
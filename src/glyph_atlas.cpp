@@ -0,0 +1,90 @@
+//
+// glyph_atlas.cpp
+// 
+// Glyph atlas implementation.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    const raster* glyph_atlas::insert(int w, int h, const uint8_t* alpha, int pitch, rct& area) {
+        // One pixel gap between glyphs.
+        int pw=w+1, ph=h+1;
+        if (pw>page_size_ || ph>page_size_) return nullptr;
+        int best=-1, x=0, y=0;
+        page* pg=nullptr;
+        for (auto& p : pages_) 
+            if (fit(*p, pw, ph, best, x, y)) { pg=p.get(); break; }
+        if (pg==nullptr) {
+            pages_.push_back(std::make_unique<page>(page_size_));
+            pg=pages_.back().get();
+            pg->pixels.premultiplied(true);
+            pg->pixels.keep_uploaded(true);
+            fit(*pg, pw, ph, best, x, y);
+        }
+        place(*pg, best, x, y, pw, ph);
+        // Premultiplied white.
+        int stride=pg->pixels.width();
+        uint32_t* dst=(uint32_t*)pg->pixels.raw()+y*stride+x;
+        for (int r=0; r<h; r++)
+            for (int c=0; c<w; c++) {
+                uint32_t a=alpha[r*pitch+c];
+                dst[r*stride+c]=a * 0x01010101;
+            }
+        area={ x, y, w, h };
+        pg->pixels.modified(area);
+        return &pg->pixels;
+    }
+
+    bool glyph_atlas::fit(const page& pg, int w, int h, int& best, int& x, int& y) const {
+        // Glyph sits on the highest node it spans. Take the lowest 
+        // such place, so that the skyline stays flat.
+        auto const& sky=pg.skyline;
+        int best_y=page_size_;
+        best=-1;
+        for (size_t i=0; i<sky.size(); i++) {
+            int nx=sky[i].x;
+            if (nx+w>page_size_) break;
+            int ny=0, covered=0;
+            for (size_t j=i; j<sky.size() && covered<w; j++) {
+                ny=std::max(ny, sky[j].y);
+                covered=sky[j].x+sky[j].w-nx;
+            }
+            if (ny+h>page_size_ || ny>=best_y) continue;
+            best_y=ny; best=(int)i; x=nx; y=ny;
+        }
+        return best>=0;
+    }
+
+    void glyph_atlas::place(page& pg, int i, int x, int y, int w, int h) {
+        auto& sky=pg.skyline;
+        sky.insert(sky.begin()+i, { x, y+h, w });
+        // Shrink or remove nodes now under the new one.
+        for (size_t j=i+1; j<sky.size(); ) {
+            int end=x+w;
+            if (sky[j].x>=end) break;
+            int cut=end-sky[j].x;
+            if (cut<sky[j].w) {
+                sky[j].x+=cut;
+                sky[j].w-=cut;
+                break;
+            }
+            sky.erase(sky.begin()+j);
+        }
+        // Merge neighbours at the same height.
+        for (size_t j=0; j+1<sky.size(); ) {
+            if (sky[j].y==sky[j+1].y) {
+                sky[j].w+=sky[j+1].w;
+                sky.erase(sky.begin()+j+1);
+            } else j++;
+        }
+    }
+//{{END.DEF}}
+
+} // namespace nice
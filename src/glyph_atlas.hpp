@@ -0,0 +1,43 @@
+//
+// glyph_atlas.hpp
+// 
+// Glyph pixels packed into raster pages with a skyline packer. Pages
+// are premultiplied white, alpha is the glyph coverage, and are kept
+// uploaded by backends. Adding a glyph only uploads its rectangle.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _GLYPH_ATLAS_HPP
+#define _GLYPH_ATLAS_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    class glyph_atlas {
+    public:
+        glyph_atlas(int page_size=512) : page_size_(page_size) {}
+        // Copy w x h coverage bytes (rows pitch apart) to a page. 
+        // Returns page and area, or nullptr if glyph is too big.
+        const raster* insert(int w, int h, const uint8_t* alpha, int pitch, rct& area);
+        int pages() const { return (int)pages_.size(); }
+    private:
+        struct node { int x, y, w; };
+        struct page {
+            page(int size) : pixels(size, size), skyline { { 0, 0, size } } {}
+            raster pixels;
+            std::vector<node> skyline;
+        };
+        // Lowest place for w x h in page, false if none.
+        bool fit(const page& pg, int w, int h, int& best, int& x, int& y) const;
+        void place(page& pg, int i, int x, int y, int w, int h);
+        int page_size_;
+        std::vector<std::unique_ptr<page>> pages_;
+    };
+//{{END.DEC}}
+
+} // namespace nice
+
+#endif // _GLYPH_ATLAS_HPP
@@ -10,10 +10,40 @@
 // 
 
 //{{BEGIN.INC}}
+// Some standard headers pull in unistd.h, its nice() clashes with our namespace.
+#define nice unix_nice
 #include <exception>
 #include <string>
 #include <sstream>
 #include <functional>
+#include <memory>
 #include <map>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include <array>
+#include <span>
+#include <algorithm>
 #include <filesystem>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <bit>
+#include <cstring>
+#include <cmath>
+#include <cassert>
+#ifdef __FREETYPE__
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#endif
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+#undef nice
 //{{END.INC}}
\ No newline at end of file
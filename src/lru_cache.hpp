@@ -0,0 +1,88 @@
+//
+// lru_cache.hpp
+// 
+// Least recently used cache with a byte budget. Values are evicted
+// (destroyed) when the sum of their sizes exceeds the budget.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _LRU_CACHE_HPP
+#define _LRU_CACHE_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    template <typename K, typename V, typename H = std::hash<K>>
+    class lru_cache {
+    public:
+        lru_cache(size_t budget) : budget_(budget) {}
+
+        // Find value and make it the most recently used, or nullptr.
+        V* find(const K& k) {
+            auto it=index_.find(k);
+            if (it==index_.end()) return nullptr;
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return &it->second->value;
+        }
+
+        // Insert or replace value, occupying bytes. The new value is
+        // never evicted, even if it alone exceeds the budget.
+        V& insert(const K& k, V&& v, size_t bytes) {
+            erase(k);
+            entries_.push_front({ k, std::move(v), bytes });
+            index_[k]=entries_.begin();
+            bytes_+=bytes;
+            evict();
+            return entries_.front().value;
+        }
+
+        void erase(const K& k) {
+            auto it=index_.find(k);
+            if (it==index_.end()) return;
+            bytes_-=it->second->bytes;
+            entries_.erase(it->second);
+            index_.erase(it);
+        }
+
+        // Erase all entries for which pred(key) is true.
+        template <typename P> void erase_if(P pred) {
+            for (auto it=entries_.begin(); it!=entries_.end(); ) {
+                if (pred(it->key)) {
+                    bytes_-=it->bytes;
+                    index_.erase(it->key);
+                    it=entries_.erase(it);
+                } else ++it;
+            }
+        }
+
+        void clear() { entries_.clear(); index_.clear(); bytes_=0; }
+
+        size_t bytes() const { return bytes_; }
+        size_t budget() const { return budget_; }
+        void budget(size_t b) { budget_=b; evict(); }
+
+    private:
+        struct entry { K key; V value; size_t bytes; };
+        // Drop least recently used (from the back), but keep the newest.
+        void evict() {
+            while (bytes_>budget_ && entries_.size()>1) {
+                auto& e=entries_.back();
+                bytes_-=e.bytes;
+                index_.erase(e.key);
+                entries_.pop_back();
+            }
+        }
+        // Front is the most recently used.
+        std::list<entry> entries_;
+        std::unordered_map<K, typename std::list<entry>::iterator, H> index_;
+        size_t bytes_ {0};
+        size_t budget_;
+    };
+//{{END.DEC}}
+
+} // namespace nice
+
+#endif // _LRU_CACHE_HPP
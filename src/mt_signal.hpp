@@ -0,0 +1,118 @@
+//
+// mt_signal.hpp
+//
+// Thread safe signals. Slots live in an immutable vector that
+// is replaced (copy on write) on connect and disconnect. Emit 
+// reads the current vector inside an epoch guard (see epoch.hpp), 
+// so it takes no lock and writes no shared memory; replaced 
+// vectors are deleted once no emit can still be reading them.
+//
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+//
+// 16.10.2026   tstih
+//
+#ifndef _MT_SIGNAL_HPP
+#define _MT_SIGNAL_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    template <typename... Args>
+    class mt_signal {
+    public:
+        mt_signal() : slots_(new slot_vector()) {}
+        mt_signal(std::function<void()> init) : mt_signal() { init_ = init; }
+        // No emit may be running.
+        ~mt_signal() { delete slots_.load(std::memory_order_acquire); }
+        template <typename T> int connect(T* inst, bool (T::* func)(Args...)) {
+            return connect([=](Args... args) {
+                return (inst->*func)(args...);
+                });
+        }
+
+        template <typename T> int connect(T* inst, bool (T::* func)(Args...) const) {
+            return connect([=](Args... args) {
+                return (inst->*func)(args...);
+                });
+        }
+
+        // Can be called from any thread and from within a slot.
+        int connect(std::function<bool(Args...)> const& slot) const {
+            if (init_ != nullptr) std::call_once(initialized_, init_);
+            auto s = std::make_shared<slot_s>(++current_id_, slot);
+            update([&s](slot_vector& v) { v.push_back(s); });
+            return s->id;
+        }
+
+        // Can be called from any thread and from within a slot. Once
+        // it returns, the slot won't be called by any new emit.
+        void disconnect(int id) const {
+            update([id](slot_vector& v) {
+                auto it = std::find_if(v.begin(), v.end(),
+                    [id](const auto& s) { return s->id==id; });
+                if (it != v.end()) {
+                    (*it)->connected = false;
+                    v.erase(it);
+                }
+            });
+        }
+
+        void disconnect_all() const {
+            update([](slot_vector& v) {
+                for (auto& s : v) s->connected = false;
+                v.clear();
+            });
+        }
+
+        // Emits to slots connected at the time of the call, skipping
+        // the ones that were disconnected meanwhile. Can be called
+        // concurrently from any number of threads.
+        void emit(const Args&... p) {
+            epoch::guard g;
+            const slot_vector* snapshot = slots_.load(std::memory_order_acquire);
+            // Iterate in reverse order to first emit to last connections.
+            for (auto it = snapshot->rbegin(); it != snapshot->rend(); ++it) {
+                if (!(*it)->connected.load(std::memory_order_relaxed)) continue;
+                if ((*it)->fn(p...)) break;
+            }
+        }
+
+    private:
+        struct slot_s {
+            slot_s(int id, std::function<bool(Args...)> const& fn)
+                : id(id), fn(fn), connected(true) {}
+            int id;
+            std::function<bool(Args...)> fn;
+            std::atomic<bool> connected;
+        };
+        typedef std::vector<std::shared_ptr<slot_s>> slot_vector;
+
+        // Copy, modify, publish. Retry if another writer was faster.
+        // The guard keeps current alive while it is copied.
+        template <typename F> void update(F modify) const {
+            const slot_vector* current;
+            {
+                epoch::guard g;
+                current = slots_.load(std::memory_order_acquire);
+                slot_vector* next = new slot_vector(*current);
+                modify(*next);
+                while (!slots_.compare_exchange_weak(current, next,
+                    std::memory_order_acq_rel, std::memory_order_acquire)) {
+                    *next = *current;
+                    modify(*next);
+                }
+            }
+            epoch::retire([current] { delete current; });
+        }
+
+        mutable std::atomic<const slot_vector*> slots_;
+        mutable std::atomic<int> current_id_{ 0 };
+        mutable std::once_flag initialized_;
+        std::function<void()> init_{ nullptr };
+    };
+//{{END.DEC}}
+
+}
+
+#endif // _MT_SIGNAL_HPP
@@ -0,0 +1,101 @@
+
+//
+// native_app.cpp
+// 
+// Application entry point & logic for the headless backend.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    app_id app::id() {
+        return ::getpid();
+    }
+
+    bool app::is_primary_instance() {
+        // Are we already primary instance? If not, try to become one.
+        if (!primary_) {
+            std::string aname = app::name();
+
+            // Pid file needs to go to /var/run
+            std::ostringstream pfname, pid;
+            pfname << "/tmp/" << aname << ".pid";
+            pid << nice::app::id() << std::endl;
+
+            // Open, lock, and forget. Let the OS close and unlock.
+            int pfd = ::open(pfname.str().c_str(), O_CREAT | O_RDWR, 0666);
+            int rc = ::flock(pfd, LOCK_EX | LOCK_NB);
+            primary_ = !(rc && EWOULDBLOCK == errno);
+            if (primary_) {
+                // Write our process id into the file.
+                ::write(pfd, pid.str().c_str(), pid.str().length());
+                return false;
+            }
+        }
+        return primary_;
+    }
+
+    // Wakes up the wait command.
+    static std::mutex wake_mutex_;
+    static std::condition_variable wake_cv_;
+    static bool woken_ = false;
+
+    void app::wake() {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        woken_=true;
+        wake_cv_.notify_one();
+    }
+
+    void app::run(const app_wnd& w) {
+
+        // We have to cast the constness away to 
+        // call non-const functions on window.
+        auto& main_wnd=const_cast<app_wnd &>(w);
+
+        // Show the window.
+        main_wnd.show();
+
+        // Main event loop. Ends when script runs out of events.
+        auto events=instance_.events;
+        bool quit=false;
+        while ( !quit && !events->empty() )
+        {
+            headless_event e=events->front();
+            events->pop_front();
+            // Frames are deterministic: time is the deadline.
+            if (e.type==headless_event_type::frame)
+                frames_.tick(frames_.deadline());
+            else if (e.type==headless_event_type::wait) {
+                // Timers and posted work run in real time.
+                auto end=timer_queue::clock::now()+std::chrono::milliseconds(e.x);
+                while (timer_queue::clock::now() < end) {
+                    {
+                        std::unique_lock<std::mutex> lock(wake_mutex_);
+                        wake_cv_.wait_until(lock, 
+                            std::min(end, timers_.deadline()), []{ return woken_; });
+                        woken_=false;
+                    }
+                    posted_.awake();
+                    std::function<void()> fn;
+                    while (posted_.pop(fn)) fn();
+                    timers_.tick();
+                }
+            } else
+                quit = native_wnd::global_wnd_proc(e);
+            // Posted work.
+            if (!quit) {
+                posted_.awake();
+                std::function<void()> fn;
+                while (posted_.pop(fn)) fn();
+            }
+        }
+    }
+//{{END.DEF}}
+
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+//
+// native_app_wnd.cpp
+// 
+// Native application window implementation for headless backend.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    native_app_wnd::native_app_wnd(
+        app_wnd *window,
+        std::string title,
+        size size
+    ) : native_wnd(window) {
+        title_=title;
+        // Remember size, the surface is created when shown.
+        requested_wsize_=size;
+        // Store window to window list.
+        wmap_.insert(std::pair<native_wnd*,native_wnd*>(this, this));
+    }
+
+    native_app_wnd::~native_app_wnd() {}
+
+    void native_app_wnd::show() const { 
+        // Mapping a window produces resize and expose first.
+        auto events=app::instance().events;
+        events->push_front({headless_event_type::expose, 0, 0, 0, ""});
+        events->push_front({
+            headless_event_type::resize, 
+            requested_wsize_.w, 
+            requested_wsize_.h,
+            0,
+            ""});
+    }
+//{{END.DEF}}
+
+} // namespace nice
@@ -0,0 +1,36 @@
+//
+// native_app_wnd.hpp
+// 
+// Native application window declaration for headless backend.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _NATIVE_APP_WND_H
+#define _NATIVE_APP_WND_H
+
+#include "native_wnd.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    class app_wnd; // Forward declaration.
+    class native_app_wnd : public native_wnd {
+    public:
+        native_app_wnd(
+            app_wnd *window,
+            std::string title,
+            size size
+        );
+        virtual ~native_app_wnd();
+        void show() const;
+    private:
+        size requested_wsize_;
+    };
+//{{END.DEC}}
+
+} // namespace nice
+
+#endif // _NATIVE_APP_WND_H 
\ No newline at end of file
@@ -0,0 +1,60 @@
+//
+// native_artist.cpp
+// 
+// Headless drawing. Straight into canvas memory.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    // Canvas is a BGRA surface.
+    static inline surface headless_surface(const canvas& c) {
+        return { (uint32_t*)c.raw, c.width, c.height, c.width };
+    }
+
+    void artist::native_draw_line(color c, pt p1, pt p2) const {
+        rasterizer::draw_line(headless_surface(canvas_), rasterizer::pixel(c), p1, p2, clip_);
+    }
+
+    void artist::native_draw_rect(color c, rct r) const {
+        rasterizer::draw_rect(headless_surface(canvas_), rasterizer::pixel(c), r, clip_);
+    }
+
+    void artist::native_fill_rect(color c, rct r) const {
+        rasterizer::fill_rect(headless_surface(canvas_), rasterizer::pixel(c), r, clip_);
+    }
+
+    void artist::native_draw_raster(const raster& rst, pt p) const {
+        if (rst.premultiplied())
+            rasterizer::blend(headless_surface(canvas_), surface_of(rst), p, clip_);
+        else
+            rasterizer::blit(headless_surface(canvas_), surface_of(rst), p, clip_);
+    }
+
+    void artist::native_draw_raster(const raster& rst, rct dst, filter f) const {
+        rasterizer::scale(headless_surface(canvas_), surface_of(rst), dst, f, 
+            rst.premultiplied(), clip_);
+    }
+
+    rct artist::native_canvas_bounds() const {
+        return { 0, 0, canvas_.width, canvas_.height };
+    }
+
+    void artist::native_draw_temporary(const raster& rst, pt p) const {
+        // Canvas is memory, nothing to cache.
+        native_draw_raster(rst, p);
+    }
+
+    void artist::native_draw_text(color c, const text_run& run, pt p) const {
+        for (auto const& q : run.quads())
+            rasterizer::fill_mask(headless_surface(canvas_), rasterizer::pixel(c), 
+                surface_of(*q.page), q.src, { p.x+q.dst.x, p.y+q.dst.y }, clip_);
+    }
+//{{END.DEF}}
+}
@@ -0,0 +1,33 @@
+//
+// native_audio.hpp
+//
+// Audio class implementation for headless backend (no sound).
+//
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+//
+// 16.10.2026   tstih
+//
+#include <audio.hpp>
+
+#include "nice.hpp"
+
+namespace nice
+{
+//{{BEGIN.DEF}}
+
+    native_audio::native_audio()
+    {
+    }
+
+    native_audio::~native_audio()
+    {
+    }
+
+    void native_audio::play_wave_async(const wave&)
+    {
+        
+    }
+
+//{{END.DEF}}
+} // namespace nice
\ No newline at end of file
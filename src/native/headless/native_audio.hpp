@@ -0,0 +1,33 @@
+//
+// native_audio.hpp
+// 
+// Native class for playing sounds on headless backend (no sound).
+//
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _NATIVE_AUDIO_HPP
+#define _NATIVE_AUDIO_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include <wave.hpp>
+
+namespace nice {
+//{{BEGIN.DEC}}
+    class native_audio {
+    public:
+        // Construct an audio class.
+        native_audio();
+        // Destructs the audio class.
+        virtual ~native_audio();
+        // Play wave.
+        void play_wave_async(const wave& w);
+    };
+//{{END.DEC}}
+} // namespace nice
+
+#endif // _NATIVE_AUDIO_HPP
\ No newline at end of file
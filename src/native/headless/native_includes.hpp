@@ -0,0 +1,29 @@
+//
+// native_includes.hpp
+// 
+// Platform dependant includes for the headless (offscreen) backend.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+
+//{{BEGIN.INC}}
+extern "C" {
+#define nice unix_nice
+#include <unistd.h>
+#undef nice
+#include <stdint.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <sys/file.h>
+}
+#include <deque>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+#include <iostream>
+//{{END.INC}}
@@ -0,0 +1,94 @@
+//
+// native_start.cpp
+// 
+// Native start up adapter functions.
+// 
+// Headless programs are driven by a script of synthetic events. 
+// If the NICE_SCRIPT environment variable points to a file, it is
+// read line by line. Supported commands are
+//  expose [n]          paint (n times)
+//  resize <w> <h>      resize window
+//  move <x> <y> [b]    move mouse, b are buttons (1=left, 2=middle, 4=right);
+//                      compressed moves are delivered by the next frame
+//  down <x> <y> <b>    press mouse button(s)
+//  up <x> <y> <b>      release mouse button(s)
+//  snapshot <file>     write canvas to binary PPM file
+//  stats               print paint timing to stdout
+//  frame [n]           emit frame signal (n times), time advances by one period
+//  wait <ms>           sleep, running timers that expire
+//  close               close window
+// Without a script the window is shown (painted once) and closed.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+//{{BEGIN.CRT}}
+extern void program();
+
+// Read script into event queue.
+static void load_script(const char *fname, std::deque<nice::headless_event>& events) {
+    std::ifstream script(fname);
+    if (!script)
+        throw_ex(nice::nice_exception,"Unable to open script.");
+    std::string line;
+    while (std::getline(script, line)) {
+        std::istringstream ls(line);
+        std::string cmd;
+        if (!(ls >> cmd) || cmd[0]=='#') continue;
+        nice::headless_event e { nice::headless_event_type::close, 0, 0, 0, "" };
+        int n=1;
+        if (cmd=="expose") {
+            e.type=nice::headless_event_type::expose; ls >> n;
+        } else if (cmd=="resize") {
+            e.type=nice::headless_event_type::resize; ls >> e.x >> e.y;
+        } else if (cmd=="move") {
+            e.type=nice::headless_event_type::mouse_move; ls >> e.x >> e.y >> e.buttons;
+        } else if (cmd=="down") {
+            e.type=nice::headless_event_type::mouse_down; ls >> e.x >> e.y >> e.buttons;
+        } else if (cmd=="up") {
+            e.type=nice::headless_event_type::mouse_up; ls >> e.x >> e.y >> e.buttons;
+        } else if (cmd=="snapshot") {
+            e.type=nice::headless_event_type::snapshot; ls >> e.arg;
+        } else if (cmd=="stats") {
+            e.type=nice::headless_event_type::stats;
+        } else if (cmd=="frame") {
+            e.type=nice::headless_event_type::frame; ls >> n;
+        } else if (cmd=="wait") {
+            e.type=nice::headless_event_type::wait; ls >> e.x;
+        } else if (cmd!="close")
+            throw_ex(nice::nice_exception,"Unknown script command.");
+        while (n-- > 0) events.push_back(e);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // Headless initialization code.
+    std::deque<nice::headless_event> events;
+    const char *script=::getenv("NICE_SCRIPT");
+    if (script)
+        load_script(script, events);
+    else
+        events.push_back({ nice::headless_event_type::close, 0, 0, 0, "" });
+
+    nice::app_instance inst;
+    inst.events=&events;
+    nice::app::instance(inst);
+
+    // Copy cmd line arguments.
+    nice::app::argc = argc;
+    nice::app::argv = argv;
+
+    // Try becoming primary instance...
+    nice::app::is_primary_instance();
+    
+    // Run program.
+    program();
+
+    // And return return code;
+    return nice::app::ret_code;
+}
+//{{END.CRT}}
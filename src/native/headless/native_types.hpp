@@ -0,0 +1,66 @@
+//
+// native_types.hpp
+// 
+// Mapping standard nice types to the headless backend.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _NATIVE_TYPES_HPP
+#define _NATIVE_TYPES_HPP
+
+#include "native_includes.hpp"
+
+namespace nice {
+
+//{{BEGIN.TYP}}
+    // Unix process id.
+    typedef pid_t app_id;
+
+    // Synthetic events, pumped by app::run.
+    enum class headless_event_type {
+        expose,         // Paint whole window.
+        paint,          // Paint invalidated area.
+        resize,         // Resize to x (width), y (height).
+        mouse_move,     // Move mouse to x,y.
+        mouse_down,     // Press buttons at x,y.
+        mouse_up,       // Release buttons at x,y.
+        snapshot,       // Write canvas to arg (binary PPM).
+        stats,          // Print paint timing to stdout.
+        frame,          // Next frame (exactly one period later).
+        wait,           // Sleep x milliseconds, running timers.
+        close           // Close the window.
+    };
+
+    typedef struct headless_event_s {
+        headless_event_type type;
+        int x;
+        int y;
+        int buttons;    // 1=left, 2=middle, 4=right
+        std::string arg;
+    } headless_event;
+
+    // Headless "display" is just the event queue.
+    typedef struct headless_app_instance {
+        std::deque<headless_event>* events;
+    } app_instance;
+
+    // Coordinate.
+    typedef int coord;
+
+    // 8 bit integer.
+    typedef uint8_t byte;
+
+    // In memory 32bpp BGRA canvas.
+    typedef struct headless_canvas {
+        uint8_t* raw;
+        int width;
+        int height;
+    } canvas;
+//{{END.TYP}}
+
+}
+
+#endif // _NATIVE_TYPES_HPP
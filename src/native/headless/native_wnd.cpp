@@ -0,0 +1,194 @@
+//
+// native_wnd.cpp
+// 
+// Native window implementation for the headless backend.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    // Static variable.
+    std::map<native_wnd*,native_wnd*> native_wnd::wmap_;
+
+    native_wnd::native_wnd(wnd *window) {
+        window_=window;
+        wsize_={0,0};
+        location_={0,0};
+    }
+
+    native_wnd::~native_wnd() {}
+
+    void native_wnd::destroy() {
+        // Remove me from windows map.
+        wmap_.erase (this); 
+    }
+
+    void native_wnd::repaint() {
+        invalidate(get_paint_area());
+    }
+
+    void native_wnd::invalidate(rct r) {
+        if (region::empty(r)) return;
+        // Queue a paint (before anything else).
+        if (dirty_.empty())
+            app::instance().events->push_front({headless_event_type::paint, 0, 0, 0, ""});
+        dirty_.add(r);
+    }
+
+    void native_wnd::update() {
+        // Clip to surface.
+        region clip;
+        for (auto const& r : dirty_.rects()) 
+            clip.add(region::intersection(r, get_paint_area()));
+        dirty_.clear();
+        if (clip.empty()) return;
+        canvas c { surface_->raw(), wsize_.w, wsize_.h };
+        artist a(c, clip);
+        auto start=std::chrono::steady_clock::now();
+        window_->paint_to(a);
+        auto elapsed=std::chrono::steady_clock::now()-start;
+        // Remember for stats.
+        frames_++;
+        paint_time_+=elapsed;
+        if (elapsed>paint_max_) paint_max_=elapsed;
+    }
+
+    void native_wnd::set_title(std::string s) {
+        title_=s;
+    };
+     
+    std::string native_wnd::get_title() {
+        return title_;
+    }
+
+    size native_wnd::get_wsize() {
+        return wsize_;
+    }
+
+    void native_wnd::set_wsize(size sz) {
+        app::instance().events->push_back(
+            {headless_event_type::resize, sz.w, sz.h, 0, ""});
+    }
+
+    pt native_wnd::get_location() {
+        return location_;
+    }
+
+    void native_wnd::set_location(pt location) {
+        location_=location;
+    }
+
+    rct native_wnd::get_paint_area() {
+        return { 0, 0, wsize_.w, wsize_.h };
+    }
+
+    bool native_wnd::get_double_buffered() {
+        return double_buffered_;
+    }
+
+    void native_wnd::set_double_buffered(bool db) {
+        double_buffered_=db;
+    }
+
+    void native_wnd::resize_surface(size sz) {
+        wsize_=sz;
+        surface_=std::make_unique<native_raster>(sz.w, sz.h);
+    }
+
+    void native_wnd::snapshot(std::string fname) {
+        std::ofstream ppm(fname, std::ios::binary);
+        ppm << "P6\n" << wsize_.w << " " << wsize_.h << "\n255\n";
+        uint8_t *p=surface_->raw();
+        for (int i=0; i<wsize_.w*wsize_.h; i++, p+=4) {
+            // BGRA to RGB.
+            char rgb[3] = { (char)p[2], (char)p[1], (char)p[0] };
+            ppm.write(rgb, 3);
+        }
+    }
+
+    // Static (global) window proc. Synthetic events don't carry
+    // a target so they go to all windows.
+    bool native_wnd::global_wnd_proc(const headless_event& e) {
+        bool quit=false;
+        // Copy, because close event modifies the map.
+        auto wmap=wmap_;
+        for(auto const& w : wmap)
+            quit = w.second->local_wnd_proc(e) || quit;
+        return quit;
+    }
+
+    // Local (per window) window proc.
+    bool native_wnd::local_wnd_proc(const headless_event& e) {
+        bool quit=false;
+        switch ( e.type )
+        {
+        case headless_event_type::close:
+            window_->destroyed.emit();
+            quit=true;
+            break;
+        case headless_event_type::expose:
+            dirty_.add(get_paint_area());
+            update();
+		    break;
+        case headless_event_type::paint:
+            update();
+		    break;
+        case headless_event_type::mouse_down:
+        case headless_event_type::mouse_up:
+        case headless_event_type::mouse_move:
+            {
+            mouse_info mi = {
+                { e.x, e.y },
+                (bool)(e.buttons&1), 
+                (bool)(e.buttons&2),
+                (bool)(e.buttons&4),
+                false,
+                false
+            };
+            if (e.type==headless_event_type::mouse_move) {
+                window_->motion(mi);
+                break;
+            }
+            // Moves before button.
+            window_->flush_motion();
+            if (e.type==headless_event_type::mouse_down)
+                window_->mouse_down.emit(mi);
+            else
+                window_->mouse_up.emit(mi);
+            }
+            break;
+        case headless_event_type::resize:
+            if (e.x!=wsize_.w || e.y!=wsize_.h) {
+                resize_surface({e.x,e.y});
+                window_->resized.emit({e.x,e.y});
+                // New surface needs paint.
+                app::instance().events->push_front({headless_event_type::expose, 0, 0, 0, ""});
+            }
+            break;
+        case headless_event_type::snapshot:
+            snapshot(e.arg);
+            break;
+        case headless_event_type::stats:
+            {
+            auto us=[](std::chrono::nanoseconds ns) { return ns.count()/1000.0; };
+            std::cout << "frames=" << frames_ 
+                << " mean_us=" << (frames_ ? us(paint_time_)/frames_ : 0)
+                << " max_us=" << us(paint_max_) << std::endl;
+            }
+            break;
+        case headless_event_type::frame:
+        case headless_event_type::wait:
+            // App events, handled by app::run.
+            break;
+        } // switch
+        return quit;
+    }
+//{{END.DEF}}
+
+} // namespace nice
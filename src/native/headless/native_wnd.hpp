@@ -0,0 +1,85 @@
+//
+// native_wnd.hpp
+// 
+// Native window for the headless backend. 
+// There is no display. A window is just geometry, a title and
+// an in-memory BGRA surface that the artist paints into.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _NATIVE_WND_H
+#define _NATIVE_WND_H
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    class wnd; // Forward declaration.
+    class native_wnd {
+    public:
+        // Ctor. 
+        native_wnd(wnd *window);
+        // Dtor.
+        virtual ~native_wnd();
+        // Destroy native window.
+        void destroy(void);
+        // Invalidate native window.
+        void repaint(void);
+        // Invalidate rectangle.
+        void invalidate(rct r);
+        // Get window title.
+        std::string get_title();
+        // Set window title.
+        void set_title(std::string s);
+        // Get window size (not client size). 
+        size get_wsize();
+        // Set window size.
+        void set_wsize(size sz);
+        // Get window relative location (to parent)
+        // or absolute location if parent is screen. 
+        pt get_location();
+        // Set window location.
+        void set_location(pt location);
+        // Get window paint rectangle.
+        rct get_paint_area();
+        // Get and set double buffering.
+        bool get_double_buffered();
+        void set_double_buffered(bool db);
+        // Global window procedure (static)
+        static bool global_wnd_proc(const headless_event& e);
+    protected:
+        // Window title.
+        std::string title_;
+        // Window geometry.
+        size wsize_;
+        pt location_;
+        // Paint surface (the screen).
+        std::unique_ptr<native_raster> surface_;
+        // Memory is always "double buffered". Just remember it.
+        bool double_buffered_ {false};
+        // Damaged area.
+        region dirty_;
+        // Paint damaged area now.
+        void update();
+        // Paint statistics.
+        int frames_ {0};
+        std::chrono::nanoseconds paint_time_ {0};
+        std::chrono::nanoseconds paint_max_ {0};
+        // All windows. There is no window handle, so we use the pointer.
+        static std::map<native_wnd*,native_wnd*> wmap_;
+        // Local window procdure.
+        virtual bool local_wnd_proc(const headless_event& e);
+        // Pointer to related non-native window struct.
+        wnd* window_;
+        // Resize (and clear) the surface.
+        void resize_surface(size sz);
+        // Write surface to binary PPM.
+        void snapshot(std::string fname);
+    };
+//{{END.DEC}}
+
+} // namespace nice
+
+#endif // _NATIVE_WND_H
@@ -41,20 +41,43 @@ namespace nice {
         return primary_;
     }
 
+    // Event that wakes up the event loop.
+    static Uint32 wake_event_ = ::SDL_RegisterEvents(1);
+
+    void app::wake() {
+        // SDL_PushEvent is thread safe.
+        SDL_Event e;
+        SDL_zero(e);
+        e.type=wake_event_;
+        ::SDL_PushEvent(&e);
+    }
+
     void app::run(const app_wnd& w) {
 
         // Show the main window.
         auto& main_wnd=const_cast<app_wnd &>(w);
         main_wnd.show();
 
+        // Frames at display refresh rate, unless told otherwise.
+        SDL_DisplayMode mode;
+        if (frames_.rate()==0 && 
+            SDL_GetCurrentDisplayMode(0, &mode)==0 && mode.refresh_rate>0)
+            frames_.rate(mode.refresh_rate);
+
         // Main event loop.
         SDL_Event e;
         /* Clean the queue */
         bool quit=false;
         while (!quit) { 
-            // Wait for something to happen.
-            SDL_WaitEvent(&e);
-            quit = native_wnd::global_wnd_proc(e);
+            // Wait for something to happen (or next frame), then drain the queue.
+            int timeout=wait_timeout();
+            bool got = timeout<0 ? SDL_WaitEvent(&e) : SDL_WaitEventTimeout(&e, timeout);
+            if (got) quit = native_wnd::global_wnd_proc(e);
+            while (!quit && SDL_PollEvent(&e))
+                quit = native_wnd::global_wnd_proc(e);
+            if (quit) break;
+            // Once per frame.
+            tick();
         }
     }
 //{{END.DEF}}
@@ -30,10 +30,14 @@ namespace nice {
         wmap_.insert(std::pair<SDL_Window*,native_wnd*>(winst_, this));
 
         // Get window surface.
-        wrenderer_=::SDL_CreateRenderer( winst_, -1, SDL_RENDERER_ACCELERATED);
+        wrenderer_=::SDL_CreateRenderer( winst_, -1, 
+            SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE);
     }
 
     native_app_wnd::~native_app_wnd() {
+        if (back_!=nullptr) ::SDL_DestroyTexture(back_);
+        // Renderer destroys its textures, cache must forget them first.
+        native_textures::purge(wrenderer_);
         ::SDL_DestroyRenderer(wrenderer_);
     }
 
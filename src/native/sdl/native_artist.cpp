@@ -15,37 +15,35 @@
 namespace nice {
 
 //{{BEGIN.DEF}}
-    void artist::draw_line(color c, pt p1, pt p2) const {
+    void artist::native_draw_line(color c, pt p1, pt p2) const {
         ::SDL_SetRenderDrawColor(canvas_, c.r, c.g, c.b, c.a);
         ::SDL_RenderDrawLine(canvas_,p1.x, p1.y, p2.x, p2.y);
     }
 
-    void artist::draw_rect(color c, rct r) const {
+    void artist::native_draw_rect(color c, rct r) const {
         SDL_Rect rdst={ r.x, r.y, r.w, r.h};
         ::SDL_SetRenderDrawColor(canvas_, c.r, c.g, c.b, c.a);
         ::SDL_RenderDrawRect(canvas_,&rdst);
     }
 
-    void artist::fill_rect(color c, rct r) const {
+    void artist::native_fill_rect(color c, rct r) const {
         SDL_Rect rdst={ r.x, r.y, r.w, r.h};
         ::SDL_SetRenderDrawColor(canvas_, c.r, c.g, c.b, c.a);
         ::SDL_RenderFillRect(canvas_,&rdst);
     }
 
-    void artist::draw_raster(const raster& rst, pt p) const {
-        
-        // Create a surface.
-        SDL_Surface *surface=SDL_CreateRGBSurfaceFrom(
-            rst.raw(),
-            rst.width(),
-            rst.height(),
-            32,
-            4*rst.width(),
-            0,0,0,0
-        );
+    void artist::native_draw_raster(const raster& rst, pt p) const {
+        // Uploaded once, and again only after raster changes.
+        SDL_Texture *texture=native_textures::get(canvas_, rst);
+        if (texture==nullptr) return;
 
-        // Get surface to texture.
-        SDL_Texture *texture = SDL_CreateTextureFromSurface(canvas_, surface);
+        // Premultiplied rasters are composited, others copied.
+        if (rst.premultiplied())
+            SDL_SetTextureBlendMode(texture, SDL_ComposeCustomBlendMode(
+                SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD));
+        else
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
 
         // Draw on window.
         SDL_Rect rsrc={ 0, 0, rst.width(), rst.height() };
@@ -56,10 +54,63 @@ namespace nice {
             &rsrc, 
             &rdst
         );
+    }
+
+    void artist::native_draw_raster(const raster& rst, rct dst, filter f) const {
+        // Box is close to linear after mipmapping.
+        SDL_Texture *texture=native_textures::get(canvas_, rst);
+        if (texture==nullptr) return;
+        SDL_SetTextureScaleMode(texture, 
+            f==filter::nearest ? SDL_ScaleModeNearest : SDL_ScaleModeLinear);
+        if (rst.premultiplied())
+            SDL_SetTextureBlendMode(texture, SDL_ComposeCustomBlendMode(
+                SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD));
+        else
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+        SDL_Rect rdst={ dst.x, dst.y, dst.w, dst.h };
+        SDL_RenderCopy(canvas_, texture, NULL, &rdst);
+    }
+
+    rct artist::native_canvas_bounds() const {
+        int w=0, h=0;
+        ::SDL_GetRendererOutputSize(canvas_, &w, &h);
+        return { 0, 0, w, h };
+    }
+
+    void artist::native_draw_temporary(const raster& rst, pt p) const {
+        SDL_Texture *texture=native_textures::scratch(canvas_, rst);
+        if (texture==nullptr) return;
+        if (rst.premultiplied())
+            SDL_SetTextureBlendMode(texture, SDL_ComposeCustomBlendMode(
+                SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD));
+        else
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+        SDL_Rect rsrc={ 0, 0, rst.width(), rst.height() };
+        SDL_Rect rdst={ p.x, p.y, rst.width(), rst.height() };
+        SDL_RenderCopy(canvas_, texture, &rsrc, &rdst);
+    }
 
-        // And free surface and texture.
-        SDL_DestroyTexture(texture);
-        SDL_FreeSurface(surface);
+    void artist::native_draw_text(color c, const text_run& run, pt p) const {
+        // Atlas pages are premultiplied white, color mod tints them.
+        const raster* page=nullptr;
+        SDL_Texture* texture=nullptr;
+        for (auto const& q : run.quads()) {
+            if (q.page!=page) {
+                page=q.page;
+                texture=native_textures::get(canvas_, *page);
+                if (texture==nullptr) continue;
+                SDL_SetTextureBlendMode(texture, SDL_ComposeCustomBlendMode(
+                    SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD,
+                    SDL_BLENDFACTOR_ONE, SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA, SDL_BLENDOPERATION_ADD));
+                SDL_SetTextureColorMod(texture, c.r, c.g, c.b);
+            }
+            if (texture==nullptr) continue;
+            SDL_Rect rsrc={ q.src.x, q.src.y, q.src.w, q.src.h };
+            SDL_Rect rdst={ p.x+q.dst.x, p.y+q.dst.y, q.src.w, q.src.h };
+            SDL_RenderCopy(canvas_, texture, &rsrc, &rdst);
+        }
     }
 //{{END.DEF}}
 }
\ No newline at end of file
@@ -29,7 +29,9 @@ namespace nice {
         raw_=std::make_unique<uint8_t[]>(len_);
     }  
 
-    native_raster::~native_raster() {}
+    native_raster::~native_raster() {
+        if (uploaded_!=0) native_textures::forget(uploaded_);
+    }
 
     int native_raster::width() const {
         return width_;
@@ -42,6 +44,10 @@ namespace nice {
     uint8_t* native_raster::raw() const {
         return raw_.get();
     }
+
+    void native_raster::uploaded(uint64_t id) {
+        uploaded_=id;
+    }
 //{{END.DEF}}
 
 }
\ No newline at end of file
@@ -30,9 +30,12 @@ namespace nice {
         int height() const;
         // Pointer to raw data.
         uint8_t* raw() const;
+        // Raster id of uploaded textures, they are destroyed with us.
+        void uploaded(uint64_t id);
     private:
         int width_, height_, len_;
         std::unique_ptr<uint8_t[]> raw_; // We own this!
+        uint64_t uploaded_ {0};
     };
 //{{END.DEC}}
 
@@ -0,0 +1,75 @@
+//
+// native_textures.cpp
+// 
+// Raster texture cache implementation.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    // Static variable.
+    lru_cache<native_textures::key, native_textures::texture, native_textures::key_hash> 
+        native_textures::cache_(64*1024*1024);
+    std::map<SDL_Renderer*, native_textures::scratch_s> native_textures::scratch_;
+
+    SDL_Texture* native_textures::get(SDL_Renderer* r, const raster& rst) {
+        key k { r, rst.id() };
+        texture* t=cache_.find(k);
+        if (t!=nullptr && t->generation==rst.generation()) return t->tex;
+        // Upload only what changed, unless new.
+        rct up { 0, 0, rst.width(), rst.height() };
+        if (t!=nullptr) up=rst.changed_since(t->generation);
+        if (t==nullptr) {
+            // BGRA bytes are ARGB little endian words.
+            SDL_Texture* tex=::SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888, 
+                SDL_TEXTUREACCESS_STATIC, rst.width(), rst.height());
+            if (tex==nullptr) return nullptr;
+            t=&cache_.insert(k, texture(tex, 0), 4 * rst.width() * rst.height());
+            rst.native()->uploaded(rst.id());
+        }
+        // (Re)upload.
+        SDL_Rect ur { up.x, up.y, up.w, up.h };
+        ::SDL_UpdateTexture(t->tex, &ur, rst.raw() + 4 * (up.y * rst.width() + up.x), 
+            4 * rst.width());
+        t->generation=rst.generation();
+        return t->tex;
+    }
+
+    SDL_Texture* native_textures::scratch(SDL_Renderer* r, const raster& rst) {
+        scratch_s& s=scratch_[r];
+        if (s.t==nullptr || s.w<rst.width() || s.h<rst.height()) {
+            // Grow, never shrink.
+            s.w=std::max(s.w, rst.width());
+            s.h=std::max(s.h, rst.height());
+            s.t.reset();
+            SDL_Texture* tex=::SDL_CreateTexture(r, SDL_PIXELFORMAT_ARGB8888, 
+                SDL_TEXTUREACCESS_STREAMING, s.w, s.h);
+            if (tex==nullptr) return nullptr;
+            s.t=std::make_unique<texture>(tex, 0);
+        }
+        SDL_Rect ur { 0, 0, rst.width(), rst.height() };
+        ::SDL_UpdateTexture(s.t->tex, &ur, rst.raw(), 4 * rst.width());
+        return s.t->tex;
+    }
+
+    void native_textures::purge(SDL_Renderer* r) {
+        cache_.erase_if([r](const key& k) { return k.first==r; });
+        scratch_.erase(r);
+    }
+
+    void native_textures::forget(uint64_t id) {
+        cache_.erase_if([id](const key& k) { return k.second==id; });
+    }
+
+    void native_textures::budget(size_t bytes) {
+        cache_.budget(bytes);
+    }
+//{{END.DEF}}
+
+} // namespace nice
@@ -0,0 +1,58 @@
+//
+// native_textures.hpp
+// 
+// Textures of rasters, one per raster and renderer. Uploaded on
+// first draw and again only when raster generation changes. Least 
+// recently used textures are destroyed above the memory budget.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _NATIVE_TEXTURES_HPP
+#define _NATIVE_TEXTURES_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    class native_textures {
+    public:
+        // Texture with current pixels of raster.
+        static SDL_Texture* get(SDL_Renderer* r, const raster& rst);
+        // Scratch texture of renderer with pixels of raster at 0,0, for 
+        // rasters drawn once. Not cached, it grows and stays until purge.
+        static SDL_Texture* scratch(SDL_Renderer* r, const raster& rst);
+        // Destroy textures of renderer (before destroying renderer).
+        static void purge(SDL_Renderer* r);
+        // Destroy textures of raster (when raster is destroyed).
+        static void forget(uint64_t id);
+        // Memory budget in bytes (default 64MB).
+        static void budget(size_t bytes);
+    private:
+        // Owns texture.
+        struct texture {
+            texture(SDL_Texture* t, uint64_t g) : tex(t), generation(g) {}
+            texture(texture&& o) : tex(o.tex), generation(o.generation) { o.tex=nullptr; }
+            ~texture() { if (tex!=nullptr) ::SDL_DestroyTexture(tex); }
+            SDL_Texture* tex;
+            uint64_t generation;
+        };
+        typedef std::pair<SDL_Renderer*, uint64_t> key; // Renderer, raster id.
+        struct key_hash {
+            size_t operator()(const key& k) const {
+                return std::hash<void*>()(k.first) ^ std::hash<uint64_t>()(k.second);
+            }
+        };
+        static lru_cache<key, texture, key_hash> cache_;
+        struct scratch_s {
+            int w, h;
+            std::unique_ptr<texture> t;
+        };
+        static std::map<SDL_Renderer*, scratch_s> scratch_;
+    };
+//{{END.DEC}}
+
+} // namespace nice
+
+#endif // _NATIVE_TEXTURES_HPP
@@ -15,6 +15,7 @@ namespace nice {
 //{{BEGIN.DEF}}
     // Static variable.
     std::map<SDL_Window*,native_wnd*> native_wnd::wmap_;
+    Uint32 native_wnd::paint_event_ = 0;
 
     native_wnd::native_wnd(wnd *window) {
         window_=window;
@@ -31,7 +32,58 @@ namespace nice {
     }
 
     void native_wnd::repaint() {
-        // TODO: Whatever.
+        invalidate(get_paint_area());
+    }
+
+    void native_wnd::invalidate(rct r) {
+        if (region::empty(r)) return;
+        // Only the first damage after paint sends event.
+        bool send=dirty_.empty();
+        dirty_.add(r);
+        if (send) {
+            if (paint_event_==0) paint_event_=::SDL_RegisterEvents(1);
+            SDL_Event e;
+            SDL_zero(e);
+            e.type=paint_event_;
+            e.user.windowID=::SDL_GetWindowID(winst_);
+            ::SDL_PushEvent(&e);
+        }
+    }
+
+    void native_wnd::update() {
+        if (dirty_.empty()) return;
+        // Paint to back buffer?
+        if (double_buffered_ && back_==nullptr) {
+            int w,h;
+            ::SDL_GetRendererOutputSize(wrenderer_, &w, &h);
+            back_=::SDL_CreateTexture(wrenderer_, 
+                SDL_PIXELFORMAT_ARGB8888, 
+                SDL_TEXTUREACCESS_TARGET, w, h);
+            // New buffer has no content.
+            dirty_.add(get_paint_area());
+        }
+        // Only back buffer keeps content between presents,
+        // without it we paint everything.
+        if (back_!=nullptr) {
+            ::SDL_SetRenderTarget(wrenderer_, back_);
+            rct b=dirty_.bounds();
+            SDL_Rect clip = { b.x, b.y, b.w, b.h };
+            ::SDL_RenderSetClipRect(wrenderer_, &clip);
+        } else {
+            dirty_.clear();
+            dirty_.add(get_paint_area());
+        }
+        // Paint event.
+        artist a(wrenderer_, dirty_);
+        window_->paint_to(a);
+        // One copy to window.
+        if (back_!=nullptr) {
+            ::SDL_RenderSetClipRect(wrenderer_, NULL);
+            ::SDL_SetRenderTarget(wrenderer_, NULL);
+            ::SDL_RenderCopy(wrenderer_, back_, NULL, NULL);
+        }
+        ::SDL_RenderPresent( wrenderer_ );
+        dirty_.clear();
     }
 
     void native_wnd::set_title(std::string s) {
@@ -69,6 +121,18 @@ namespace nice {
         return { 0,0,w,h };
     }
 
+    bool native_wnd::get_double_buffered() {
+        return double_buffered_;
+    }
+
+    void native_wnd::set_double_buffered(bool db) {
+        // Not all renderers can render to texture.
+        double_buffered_=db && ::SDL_RenderTargetSupported(wrenderer_);
+        if (!double_buffered_ && back_!=nullptr) {
+            ::SDL_DestroyTexture(back_); back_=nullptr;
+        }
+    }
+
     // TODO:for now SDL only has one window so we're
     // assuming the first entry in the map, but we're
     // ready for more!
@@ -85,18 +149,19 @@ namespace nice {
             case SDL_WINDOWEVENT:
                 switch (e.window.event) {
                     case SDL_WINDOWEVENT_EXPOSED:
-                    {
-                        // Paint event.
-                        artist a(wrenderer_);
-                        window_->paint.emit(a);
-                        ::SDL_RenderPresent( wrenderer_ );
-                    }
+                        // System expose is always whole window.
+                        dirty_.add(get_paint_area());
+                        update();
                     break;
                     case SDL_WINDOWEVENT_SIZE_CHANGED:
                     {
                         // Resize event.
                         int width = e.window.data1;
                         int height = e.window.data2;
+                        // Back buffer is recreated on next paint.
+                        if (back_!=nullptr) {
+                            ::SDL_DestroyTexture(back_); back_=nullptr;
+                        }
                         window_->resized.emit({width, height});
                     }
                     break;
@@ -107,8 +172,24 @@ namespace nice {
                 }
             break;
             case SDL_MOUSEBUTTONDOWN:
-            break;
             case SDL_MOUSEBUTTONUP:
+            {
+                Uint32 state=::SDL_GetMouseState(NULL, NULL);
+                mouse_info mi = {
+                    {e.button.x, e.button.y}, // point
+                    (bool)(state & SDL_BUTTON_LMASK),
+                    (bool)(state & SDL_BUTTON_MMASK),
+                    (bool)(state & SDL_BUTTON_RMASK),
+                    false, // TODO: Shift and Ctrl status.
+                    false
+                };
+                // Moves before button.
+                window_->flush_motion();
+                if (e.type==SDL_MOUSEBUTTONDOWN)
+                    window_->mouse_down.emit(mi);
+                else
+                    window_->mouse_up.emit(mi);
+            }
             break;
             case SDL_MOUSEMOTION:
             {
@@ -120,8 +201,12 @@ namespace nice {
                     false, // TODO: Shift and Ctrl status.
                     false
                 };
+                window_->motion(mi);
             }
             break;
+            default:
+                if (e.type==paint_event_) update();
+            break;
         }
         return quit;
     }
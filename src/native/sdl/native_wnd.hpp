@@ -29,6 +29,8 @@ namespace nice {
         void destroy(void);
         // Invalidate native window.
         void repaint(void);
+        // Invalidate rectangle.
+        void invalidate(rct r);
         // Get window title.
         std::string get_title();
         // Set window title.
@@ -44,6 +46,9 @@ namespace nice {
         void set_location(pt location);
         // Get window paint rectangle.
         rct get_paint_area();
+        // Get and set double buffering.
+        bool get_double_buffered();
+        void set_double_buffered(bool db);
         // Global window procedure (static)
         static bool global_wnd_proc(const SDL_Event& e);
     protected:
@@ -51,6 +56,15 @@ namespace nice {
         SDL_Window* winst_; 
         // Window surface.
         SDL_Renderer *wrenderer_;
+        // Back buffer (render target texture). Created lazily.
+        bool double_buffered_ {false};
+        SDL_Texture *back_ {nullptr};
+        // Damaged area.
+        region dirty_;
+        // Paint damaged area now.
+        void update();
+        // Our own event, sent by invalidate.
+        static Uint32 paint_event_;
         // A map from X11 window to native_wnd.
         static std::map<SDL_Window *,native_wnd*> wmap_;
         // Local window procdure.
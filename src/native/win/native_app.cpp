@@ -32,19 +32,53 @@ namespace nice {
         return primary_;
     }
 
+    // Event loop thread.
+    static std::atomic<DWORD> loop_thread_id_ { 0 };
+
+    void app::wake() {
+        // Thread messages wake up MsgWaitForMultipleObjects. Before
+        // run() there is no loop thread, let the next post try again.
+        if (!::PostThreadMessage(loop_thread_id_.load(), WM_NULL, 0, 0))
+            posted_.awake();
+    }
+
     void app::run(const app_wnd& w) {
 
+        // Posted work wakes up this thread.
+        loop_thread_id_.store(::GetCurrentThreadId());
+
         // We have to cast the constness away to 
         // call non-const functions on window.
         auto& main_wnd=const_cast<app_wnd &>(w);
         main_wnd.show();
 
+        // Work posted before the loop started woke nobody.
+        tick();
+
+        // Frames at display refresh rate, unless told otherwise.
+        // 0 and 1 mean hardware default.
+        DEVMODE mode {};
+        mode.dmSize=sizeof(mode);
+        if (frames_.rate()==0 && 
+            ::EnumDisplaySettings(NULL, ENUM_CURRENT_SETTINGS, &mode) &&
+            mode.dmDisplayFrequency>1)
+            frames_.rate((int)mode.dmDisplayFrequency);
+
         // Message loop.
         MSG msg;
-        while (::GetMessage(&msg, NULL, 0, 0))
+        bool quit=false;
+        while (!quit)
         {
-            ::TranslateMessage(&msg);
-            ::DispatchMessage(&msg);
+            // Wait for a message or next frame.
+            int timeout=wait_timeout();
+            ::MsgWaitForMultipleObjects(0, NULL, FALSE, 
+                timeout<0 ? INFINITE : timeout, QS_ALLINPUT);
+            while (::PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
+                if (msg.message==WM_QUIT) { quit=true; break; }
+                ::TranslateMessage(&msg);
+                ::DispatchMessage(&msg);
+            }
+            if (!quit) tick();
         }
 
         // Finally, set the return code.
@@ -13,7 +13,7 @@
 namespace nice {
 
 //{{BEGIN.DEF}}
-    void artist::draw_line(color c, pt p1, pt p2) const {
+    void artist::native_draw_line(color c, pt p1, pt p2) const {
         HPEN pen = ::CreatePen(PS_SOLID, 1, RGB(c.r, c.g, c.b));
         ::SelectObject(canvas_, pen);
         POINT pt;
@@ -22,14 +22,14 @@ namespace nice {
         ::DeleteObject(pen);
     }
 
-    void artist::draw_rect(color c, rct r) const {
+    void artist::native_draw_rect(color c, rct r) const {
         RECT rect{ r.left, r.top, r.x2(), r.y2() };
         HBRUSH brush = ::CreateSolidBrush(RGB(c.r, c.g, c.b));
         ::FrameRect(canvas_, &rect, brush);
         ::DeleteObject(brush);
     }
 
-    void artist::fill_rect(color c, rct r) const {   
+    void artist::native_fill_rect(color c, rct r) const {   
         RECT rect{ r.left, r.top, r.x2(), r.y2() };
         HBRUSH brush = ::CreateSolidBrush(RGB(c.r, c.g, c.b));
         ::FillRect(canvas_, &rect, brush);
@@ -39,15 +39,39 @@ namespace nice {
     // Know how from: https://www-user.tu-chemnitz.de/~heha/petzold/ch14e.htm
     // http://www.winprog.org/tutorial/bitmaps.html
     // http://www.fengyuan.com/article/alphablend.html
-    void artist::draw_raster(const raster& rst, pt p) const {
+    void artist::native_draw_raster(const raster& rst, pt p) const {
+        if (rst.premultiplied()) {
+            // AlphaBlend needs a selected 32 bit DIB.
+            BITMAPINFO bmi;
+            ::ZeroMemory(&bmi, sizeof(BITMAPINFO));
+            bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+            bmi.bmiHeader.biWidth = rst.width();
+            bmi.bmiHeader.biHeight = -(rst.height());
+            bmi.bmiHeader.biPlanes = 1;
+            bmi.bmiHeader.biBitCount = 32;
+            bmi.bmiHeader.biCompression = BI_RGB;
+            void* bits;
+            HBITMAP dib = ::CreateDIBSection(canvas_, &bmi, DIB_RGB_COLORS, &bits, NULL, 0);
+            std::memcpy(bits, rst.raw(), 4 * rst.width() * rst.height());
+            HDC mem = ::CreateCompatibleDC(canvas_);
+            HGDIOBJ old = ::SelectObject(mem, dib);
+            BLENDFUNCTION bf { AC_SRC_OVER, 0, 255, AC_SRC_ALPHA };
+            // Gdi32 export of AlphaBlend, no msimg32 needed.
+            ::GdiAlphaBlend(canvas_, p.x, p.y, rst.width(), rst.height(),
+                mem, 0, 0, rst.width(), rst.height(), bf);
+            ::SelectObject(mem, old);
+            ::DeleteDC(mem);
+            ::DeleteObject(dib);
+            return;
+        }
         BITMAPINFO bmi;
         ::ZeroMemory(&bmi, sizeof(BITMAPINFO));
         bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
         bmi.bmiHeader.biWidth = rst.width();
         bmi.bmiHeader.biHeight = -(rst.height()); // Windows magic. Rasters are bottom up.
         bmi.bmiHeader.biPlanes = 1;
-        bmi.bmiHeader.biBitCount = 24;
-        bmi.bmiHeader.biCompression = BI_RGB; // But it is really BGR!
+        bmi.bmiHeader.biBitCount = 32;
+        bmi.bmiHeader.biCompression = BI_RGB; // But it is really BGRA!
         ::SetDIBitsToDevice(canvas_,
             p.x, p.y, rst.width(), rst.height(),
             0, 0,
@@ -57,5 +81,27 @@ namespace nice {
             DIB_RGB_COLORS
         );
     }
+
+    void artist::native_draw_raster(const raster& rst, rct dst, filter f) const {
+        // Scaled in software, then drawn 1:1.
+        draw_raster_scaled(rst, dst, f);
+    }
+
+    rct artist::native_canvas_bounds() const {
+        // Client area, or the part of it being painted.
+        RECT r;
+        if (::GetClipBox(canvas_, &r)==ERROR) return { 0, 0, 0, 0 };
+        return { r.left, r.top, r.right-r.left, r.bottom-r.top };
+    }
+
+    void artist::native_draw_temporary(const raster& rst, pt p) const {
+        // Nothing is cached, same as any raster.
+        native_draw_raster(rst, p);
+    }
+
+    void artist::native_draw_text(color c, const text_run& run, pt p) const {
+        // GDI can't tint the atlas, glyphs are blended in software.
+        draw_text_raster(c, run, p);
+    }
 //{{END.DEF}}
 }
\ No newline at end of file
@@ -13,6 +13,7 @@
 
 //{{BEGIN.INC}}
 extern "C" {
+#define NOMINMAX
 #include <windows.h>
 #include <windowsx.h>
 }
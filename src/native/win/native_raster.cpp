@@ -15,14 +15,8 @@ namespace nice {
 //{{BEGIN.DEF}}
     native_raster::native_raster(int width, int height, const uint8_t *bgra) :
         native_raster(width,height) {
-        // For windows we need 24 bit BGR array.
-        uint8_t *dst=raw_.get();
-        for (int i=0; i<width*height; i++) {
-            int srci=4*i, dsti=3*i;
-            dst[dsti] = bgra[srci];
-            dst[dsti+1] = bgra[srci+1];
-            dst[dsti+2] = bgra[srci+2];
-        }
+        // Copy complete BGRA array.
+        std::copy(bgra, bgra+len_, raw_.get());
     }
     
     native_raster::native_raster(int width, int height) :
@@ -30,7 +24,7 @@ namespace nice {
         height_(height) {
 
         // Calculate raster length.
-        len_ = width * height * 3; // BGRA!
+        len_ = width * height * 4; // BGRA!
         // Allocate memory.
         raw_=std::make_unique<uint8_t[]>(len_);
     }  
@@ -22,11 +22,17 @@ namespace nice {
     }
 
     native_wnd::~native_wnd() {
+        if (back_!=NULL) ::DeleteObject(back_);
         ::DestroyWindow(hwnd_);
     }
 
     void native_wnd::repaint(void) {
-         ::InvalidateRect(hwnd_, NULL, TRUE);
+         ::InvalidateRect(hwnd_, NULL, !double_buffered_);
+    }
+
+    void native_wnd::invalidate(rct r) {
+        RECT rect{ r.left, r.top, r.x2(), r.y2() };
+        ::InvalidateRect(hwnd_, &rect, !double_buffered_);
     }
 
     std::string native_wnd::get_title() {
@@ -75,6 +81,15 @@ namespace nice {
         return { client.left, client.top, client.right, client.bottom };
     }
 
+    bool native_wnd::get_double_buffered() {
+        return double_buffered_;
+    }
+
+    void native_wnd::set_double_buffered(bool db) {
+        double_buffered_=db;
+        if (!db && back_!=NULL) { ::DeleteObject(back_); back_=NULL; }
+    }
+
     LRESULT CALLBACK native_wnd::global_wnd_proc(
         HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam) {
         
@@ -113,11 +128,36 @@ namespace nice {
             {
                 PAINTSTRUCT ps;
                 HDC hdc = BeginPaint(hwnd_, &ps);
-                artist a(hdc);
-                window_->paint.emit(a);
+                // GDI clips to update rectangle.
+                RECT& u=ps.rcPaint;
+                region dirty;
+                dirty.add({ u.left, u.top, u.right-u.left, u.bottom-u.top });
+                if (double_buffered_) {
+                    RECT client;
+                    ::GetClientRect(hwnd_, &client);
+                    if (back_==NULL)
+                        back_=::CreateCompatibleBitmap(hdc, client.right, client.bottom);
+                    // Paint to memory DC and copy it to window.
+                    HDC mdc=::CreateCompatibleDC(hdc);
+                    HGDIOBJ prev=::SelectObject(mdc, back_);
+                    ::IntersectClipRect(mdc, u.left, u.top, u.right, u.bottom);
+                    artist a(mdc, dirty);
+                    window_->paint_to(a);
+                    ::BitBlt(hdc, u.left, u.top, u.right-u.left, u.bottom-u.top, 
+                        mdc, u.left, u.top, SRCCOPY);
+                    ::SelectObject(mdc, prev);
+                    ::DeleteDC(mdc);
+                } else {
+                    artist a(hdc, dirty);
+                    window_->paint_to(a);
+                }
                 EndPaint(hwnd_, &ps);
             }
             break;
+            case WM_ERASEBKGND:
+                // Back buffer paints everything, erasing would flicker.
+                if (double_buffered_) return 1;
+                return ::DefWindowProc(hwnd_, msg, wparam, lparam);
             case WM_MOUSEMOVE:
             case WM_LBUTTONDOWN:
             case WM_MBUTTONDOWN:
@@ -135,9 +175,13 @@ namespace nice {
                     (bool)(wparam & MK_CONTROL),
                     (bool)(wparam & MK_SHIFT)
                 };
-                if (msg == WM_MOUSEMOVE)
-                    window_->mouse_move.emit(mi);
-                else if (msg == WM_LBUTTONDOWN || msg == WM_MBUTTONDOWN || msg == WM_RBUTTONDOWN)
+                if (msg == WM_MOUSEMOVE) {
+                    window_->motion(mi);
+                    break;
+                }
+                // Moves before button.
+                window_->flush_motion();
+                if (msg == WM_LBUTTONDOWN || msg == WM_MBUTTONDOWN || msg == WM_RBUTTONDOWN)
                     window_->mouse_down.emit(mi);
                 else
                     window_->mouse_up.emit(mi);
@@ -146,6 +190,11 @@ namespace nice {
             case WM_SIZE:
             {
                 rct r = rct{ 0, 0, LOWORD(lparam), HIWORD(lparam) };
+                // Back buffer is recreated on next paint, and needs all of it.
+                if (back_!=NULL) { 
+                    ::DeleteObject(back_); back_=NULL; 
+                    ::InvalidateRect(hwnd_, NULL, FALSE);
+                }
                 window_->resized.emit(
                     {
                         LOWORD(lparam),
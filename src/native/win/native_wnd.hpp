@@ -23,6 +23,7 @@ namespace nice {
         // Method(s).
         void destroy(void);
         void repaint(void);
+        void invalidate(rct r);
         std::string get_title();
         void set_title(std::string s); 
         size get_wsize();
@@ -30,6 +31,8 @@ namespace nice {
         pt get_location();
         void set_location(pt location);
         rct get_paint_area();
+        bool get_double_buffered();
+        void set_double_buffered(bool db);
     protected:
         // Window variables.
         HWND hwnd_;
@@ -41,6 +44,9 @@ namespace nice {
         virtual LRESULT local_wnd_proc(
             UINT msg, WPARAM wparam, LPARAM lparam);
         wnd* window_;
+        // Back buffer. Created lazily, freed on resize.
+        bool double_buffered_ {false};
+        HBITMAP back_ {NULL};
     };
 //{{END.DEC}}
 
@@ -41,6 +41,11 @@ namespace nice {
         return primary_;
     }
 
+    void app::wake() {
+        char c=0;
+        ::write(instance_.wake[1], &c, 1);
+    }
+
     void app::run(const app_wnd& w) {
 
         // We have to cast the constness away to 
@@ -53,13 +58,55 @@ namespace nice {
         // Flush it all.
         ::XFlush(instance_.display);
 
+#ifdef __XRANDR__
+        // Frames at display refresh rate, unless told otherwise.
+        // Without RandR frame clock runs at 60 Hz.
+        int evb, erb;
+        Display* d=instance_.display;
+        if (frames_.rate()==0 && ::XRRQueryExtension(d, &evb, &erb)) {
+            XRRScreenConfiguration* sc=::XRRGetScreenInfo(d, DefaultRootWindow(d));
+            if (sc!=nullptr) {
+                short rate=::XRRConfigCurrentRate(sc);
+                if (rate>0) frames_.rate(rate);
+                ::XRRFreeScreenConfigInfo(sc);
+            }
+        }
+#endif
+
+        // Completions of shared memory puts, waited for by rasters.
+        int shm_done=::XShmQueryExtension(instance_.display) 
+            ? ::XShmGetEventBase(instance_.display)+ShmCompletion : -1;
+
         // Main event loop.
         XEvent e;
         bool quit=false;
+        pollfd pfd[2] { 
+            { ConnectionNumber(instance_.display), POLLIN, 0 },
+            { instance_.wake[0], POLLIN, 0 }
+        };
 	    while ( !quit ) // Will be interrupted by the OS.
 	    {
-	      ::XNextEvent ( instance_.display,&e );
-	      quit = native_wnd::global_wnd_proc(e);
+            // Wait for an event, wake up, or next frame (XPending also flushes).
+            if (!::XPending(instance_.display)) {
+                ::poll(pfd, 2, wait_timeout());
+                char buf[64];
+                if (pfd[1].revents & POLLIN)
+                    while (::read(instance_.wake[0], buf, sizeof(buf))>0);
+            }
+            // Drain the events that are here now, a client flooding us
+            // must not starve frames. Expose and configure events 
+            // are only collected by windows...
+            int n=::XEventsQueued(instance_.display, QueuedAfterReading);
+            while ( !quit && n-- > 0 ) {
+                ::XNextEvent ( instance_.display,&e );
+                if (e.type==shm_done) continue;
+                quit = native_wnd::global_wnd_proc(e);
+            }
+            if (quit) break;
+            // Posted work, timer and frame handlers can invalidate windows...
+            tick();
+            // ...and everything is handled here, once per window.
+            native_wnd::global_update();
 	    }
     }
 //{{END.DEF}}
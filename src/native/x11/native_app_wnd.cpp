@@ -20,17 +20,21 @@ namespace nice {
     ) : native_wnd(window) {
 
         int s = DefaultScreen(display_);
+        geometry_={ 10, 10, size.width, size.height };
+        title_=title;
         winst_ = ::XCreateSimpleWindow(
             display_, 
             RootWindow(display_, s), 
-            10, // x 
-            10, // y
-            size.width, 
-            size.height, 
+            geometry_.x, 
+            geometry_.y,
+            geometry_.w, 
+            geometry_.h, 
             1, // border width
             BlackPixel(display_, s), // border color
             WhitePixel(display_, s)  // background color
         );
+        // No resize until the size changes.
+        cached_wsize_=configured_wsize_={ geometry_.w, geometry_.h };
         // Store window to window list.
         wmap_.insert(std::pair<Window,native_wnd*>(winst_, this));
         // Set initial title.
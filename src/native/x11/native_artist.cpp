@@ -15,54 +15,247 @@
 namespace nice {
 
 //{{BEGIN.DEF}}
-    void artist::draw_line(color c, pt p1, pt p2) const {
+    // Queue primitive to canvas batch or, if there is none, draw it now.
+    template<typename F>
+    static inline void x11_batch(const canvas& c, F f) {
+        if (c.batch!=nullptr) 
+            f(*c.batch);
+        else {
+            native_batch b;
+            f(b);
+            b.flush();
+        }
     }
 
-    void artist::draw_rect(color c, rct r) const {   
+    void artist::native_draw_line(color c, pt p1, pt p2) const {
+        unsigned long px=native_colors::of(canvas_.d).pixel(c);
+        x11_batch(canvas_, [&](native_batch& b) { b.draw_line(canvas_, px, p1, p2); });
     }
 
-    void artist::fill_rect(color c, rct r) const {   
-        // 1000 mile walk to create a simple RGB color.
-        Colormap cmap=DefaultColormap(canvas_.d,DefaultScreen(canvas_.d));    
-        XColor xc;
-        xc.red=c.r * 0xff; 
-        xc.green=c.g * 0xff; 
-        xc.blue=c.b * 0xff;
-        xc.flags = DoRed | DoGreen | DoBlue;
-        XAllocColor(canvas_.d, cmap, &xc);
-        // Set pen.
-        XSetForeground(canvas_.d, canvas_.gc, xc.pixel);
-        // And fill rect.
-        XFillRectangle( canvas_.d, canvas_.w, canvas_.gc, r.x, r.y, r.w, r.h );
+    void artist::native_draw_rect(color c, rct r) const {   
+        if (region::empty(r) || (!clip_.empty() && !clip_.intersects(r))) return;
+        unsigned long px=native_colors::of(canvas_.d).pixel(c);
+        x11_batch(canvas_, [&](native_batch& b) { b.draw_rect(canvas_, px, r); });
     }
 
-    void artist::draw_raster(const raster& rst, pt p) const {
-        // Get the visual.
-        Visual *visual=DefaultVisual(canvas_.d, DefaultScreen(canvas_.d));
-        // Create the iage.
-        XImage* img=XCreateImage(
-            canvas_.d, 
-            visual, 
-            24, 
-            ZPixmap, 
-            0, 
-            (char*)rst.raw(),
-            rst.width(),
-            rst.height(),
-            32,
-            0);
-        // Draw it!
-        XPutImage(
-            canvas_.d, 
-            canvas_.w, 
-            canvas_.gc, 
-            img, 
-            0, 0, p.x, p.y, 
-            rst.width(), rst.height());
-        // We don't want our raster object wildly released by XDestroyImage.
+    void artist::native_fill_rect(color c, rct r) const {   
+        if (region::empty(r) || (!clip_.empty() && !clip_.intersects(r))) return;
+        unsigned long px=native_colors::of(canvas_.d).pixel(c);
+        x11_batch(canvas_, [&](native_batch& b) { b.fill_rect(canvas_, px, r); });
+    }
+
+    // Set by X error handler when reading the drawable fails.
+    static bool x11_read_failed_;
+    static int x11_read_error_handler(Display *, XErrorEvent *) {
+        x11_read_failed_=true;
+        return 0;
+    }
+
+    // Largest area (pixels) blended by reading the background back.
+    static const int x11_readback_max=128*128;
+
+    // Larger rasters are drawn where they are at least half opaque,
+    // through a 1 bit clip mask. Edges are not antialiased, but there 
+    // is no round trip.
+    static void x11_mask_raster(const canvas& c, const raster& rst, pt p, 
+        const region& clip, rct f) {
+        int bpl=(f.w+7)/8;
+        std::vector<uint8_t> bits(bpl*f.h, 0);
+        std::vector<uint32_t> px(f.w*f.h);
+        auto src=(const uint32_t*)rst.raw();
+        auto mark=[&](rct r) {
+            for (int y=r.y; y<r.y+r.h; y++) 
+                for (int x=r.x; x<r.x+r.w; x++) {
+                    uint32_t s=src[(y-p.y)*rst.width()+x-p.x], a=s>>24;
+                    if (a<128) continue;
+                    int i=(y-f.y)*f.w+x-f.x;
+                    // Color without alpha.
+                    px[i]=(((s>>16&0xff)*255/a)<<16) | (((s>>8&0xff)*255/a)<<8) 
+                        | ((s&0xff)*255/a);
+                    bits[(y-f.y)*bpl+(x-f.x)/8]|=1<<((x-f.x)%8);
+                }
+        };
+        if (clip.empty()) 
+            mark(f);
+        else for (auto const& r : clip.rects()) {
+            rct cr=region::intersection(r, f);
+            if (!region::empty(cr)) mark(cr);
+        }
+        Visual* v=DefaultVisual(c.d, DefaultScreen(c.d));
+        XImage* mask=::XCreateImage(c.d, v, 1, XYPixmap, 0, (char*)bits.data(), 
+            f.w, f.h, 8, bpl);
+        XImage* img=::XCreateImage(c.d, v, 24, ZPixmap, 0, (char*)px.data(), 
+            f.w, f.h, 32, 0);
+        if (mask!=nullptr && img!=nullptr) {
+            mask->byte_order=mask->bitmap_bit_order=LSBFirst;
+            Pixmap mp=::XCreatePixmap(c.d, c.w, f.w, f.h, 1);
+            GC mgc=::XCreateGC(c.d, mp, 0, nullptr);
+            ::XPutImage(c.d, mp, mgc, mask, 0, 0, 0, 0, f.w, f.h);
+            ::XFreeGC(c.d, mgc);
+            // Mask includes clip.
+            XGCValues gv {};
+            gv.clip_mask=mp;
+            gv.clip_x_origin=f.x;
+            gv.clip_y_origin=f.y;
+            GC gc=::XCreateGC(c.d, c.w, GCClipMask|GCClipXOrigin|GCClipYOrigin, &gv);
+            ::XPutImage(c.d, c.w, gc, img, 0, 0, f.x, f.y, f.w, f.h);
+            ::XFreeGC(c.d, gc);
+            ::XFreePixmap(c.d, mp);
+        }
+        if (mask!=nullptr) { mask->data=NULL; XDestroyImage(mask); }
+        if (img!=nullptr) { img->data=NULL; XDestroyImage(img); }
+    }
+
+    // Core protocol can't blend. Read the background back, blend 
+    // premultiplied raster over it and write it back. This is a 
+    // round trip per call, so only for small areas (see above). 
+    // If the background can't be read, the mask is used too.
+    static void x11_blend_raster(const canvas& c, const raster& rst, pt p, const region& clip) {
+        rct f=region::intersection(
+            { p.x, p.y, rst.width(), rst.height() }, { 0, 0, c.width, c.height });
+        if (!clip.empty()) f=region::intersection(f, clip.bounds());
+        if (region::empty(f)) return;
+        if (f.w*f.h>x11_readback_max) {
+            x11_mask_raster(c, rst, p, clip, f);
+            return;
+        }
+        // Unmapped or obscured window can't be read.
+        x11_read_failed_=false;
+        auto handler=::XSetErrorHandler(x11_read_error_handler);
+        XImage* img=::XGetImage(c.d, c.w, f.x, f.y, f.w, f.h, AllPlanes, ZPixmap);
+        ::XSetErrorHandler(handler);
+        // Only the (usual) layout of our rasters.
+        if (img!=nullptr && (x11_read_failed_ || img->bits_per_pixel!=32 
+            || img->byte_order!=LSBFirst || img->red_mask!=0xff0000 || img->blue_mask!=0xff)) {
+            XDestroyImage(img);
+            img=nullptr;
+        }
+        if (img==nullptr) {
+            x11_mask_raster(c, rst, p, clip, f);
+            return;
+        }
+        surface dst { (uint32_t*)img->data, f.w, f.h, img->bytes_per_line/4 };
+        surface src { (uint32_t*)rst.raw(), rst.width(), rst.height(), rst.width() };
+        rasterizer::blend(dst, src, { p.x-f.x, p.y-f.y }, region());
+        // GC clips to damaged area.
+        ::XPutImage(c.d, c.w, c.gc, img, 0, 0, f.x, f.y, f.w, f.h);
+        XDestroyImage(img);
+    }
+
+    void artist::native_draw_raster(const raster& rst, pt p) const {
+        // Keep drawing order.
+        if (canvas_.batch!=nullptr) canvas_.batch->flush();
+        // Transparent raster? Server composites it, or we do.
+        if (rst.premultiplied()) {
+            native_xrender* xr;
+            if (canvas_.picture!=0 && (xr=native_xrender::of(canvas_.d))!=nullptr) {
+                auto* src=native_pixmaps::get(canvas_.d, rst, true);
+                if (src!=nullptr) {
+                    xr->composite(PictOpOver, src->picture, { rst.width(), rst.height() }, 
+                        canvas_.picture, { p.x, p.y, rst.width(), rst.height() });
+                    return;
+                }
+            }
+            x11_blend_raster(canvas_, rst, p, clip_);
+            return;
+        }
+        // Static raster? Server local copy.
+        if (rst.keep_uploaded()) {
+            auto* src=native_pixmaps::get(canvas_.d, rst, false);
+            if (src!=nullptr) {
+                ::XCopyArea(canvas_.d, src->pix, canvas_.w, canvas_.gc, 
+                    0, 0, rst.width(), rst.height(), p.x, p.y);
+                return;
+            }
+        }
+        // Get cached image.
+        native_raster *nr=rst.native();
+        XImage* img=nr->image(canvas_.d);
+        if (img==nullptr) return;
+        // Draw it! Shared memory avoids pushing pixels through the socket.
+        nr->put(canvas_.d, canvas_.w, canvas_.gc, img, 
+            { 0, 0, rst.width(), rst.height() }, p);
+    }
+
+    // Image over raster pixels, not cached and not shared.
+    static XImage* x11_image(Display* d, const raster& rst, int depth) {
+        return ::XCreateImage(d, DefaultVisual(d, DefaultScreen(d)), depth, ZPixmap, 0, 
+            (char*)rst.raw(), rst.width(), rst.height(), 32, 0);
+    }
+
+    rct artist::native_canvas_bounds() const {
+        return { 0, 0, canvas_.width, canvas_.height };
+    }
+
+    void artist::native_draw_temporary(const raster& rst, pt p) const {
+        // Keep drawing order.
+        if (canvas_.batch!=nullptr) canvas_.batch->flush();
+        int w=rst.width(), h=rst.height();
+        if (rst.premultiplied()) {
+            // Put to the scratch pixmap and composite from there.
+            native_xrender* xr;
+            native_pixmaps::pixmap* s;
+            if (canvas_.picture!=0 && (xr=native_xrender::of(canvas_.d))!=nullptr
+                && (s=native_pixmaps::scratch(canvas_.d, w, h))!=nullptr) {
+                XImage* img=x11_image(canvas_.d, rst, 32);
+                if (img==nullptr) return;
+                ::XPutImage(canvas_.d, s->pix, s->gc, img, 0, 0, 0, 0, w, h);
+                img->data=NULL;
+                XDestroyImage(img);
+                xr->composite(PictOpOver, s->picture, { w, h }, 
+                    canvas_.picture, { p.x, p.y, w, h });
+                return;
+            }
+            x11_blend_raster(canvas_, rst, p, clip_);
+            return;
+        }
+        XImage* img=x11_image(canvas_.d, rst, 24);
+        if (img==nullptr) return;
+        ::XPutImage(canvas_.d, canvas_.w, canvas_.gc, img, 0, 0, p.x, p.y, w, h);
         img->data=NULL;
-        // Destroy the image.
         XDestroyImage(img);
     }
+
+    void artist::native_draw_raster(const raster& rst, rct dst, filter f) const {
+        native_xrender* xr;
+        native_pixmaps::pixmap* src;
+        if (canvas_.picture==0 || (xr=native_xrender::of(canvas_.d))==nullptr 
+            || (src=native_pixmaps::get(canvas_.d, rst, true))==nullptr) {
+            draw_raster_scaled(rst, dst, f);
+            return;
+        }
+        // Keep drawing order.
+        if (canvas_.batch!=nullptr) canvas_.batch->flush();
+        // Server scales. Box is close to bilinear after mipmapping.
+        xr->composite(rst.premultiplied() ? PictOpOver : PictOpSrc, src->picture, 
+            { rst.width(), rst.height() }, canvas_.picture, dst, f!=filter::nearest);
+    }
+
+    void artist::native_draw_text(color c, const text_run& run, pt p) const {
+        native_xrender* xr;
+        if (canvas_.picture==0 || (xr=native_xrender::of(canvas_.d))==nullptr) {
+            draw_text_raster(c, run, p);
+            return;
+        }
+        // Keep drawing order.
+        if (canvas_.batch!=nullptr) canvas_.batch->flush();
+        // Color through glyph alpha (atlas pages are the mask).
+        XRenderColor rc { 
+            (unsigned short)(c.r*257), (unsigned short)(c.g*257), 
+            (unsigned short)(c.b*257), 0xffff };
+        Picture solid=::XRenderCreateSolidFill(canvas_.d, &rc);
+        const raster* page=nullptr;
+        native_pixmaps::pixmap* mask=nullptr;
+        for (auto const& q : run.quads()) {
+            if (q.page!=page) {
+                page=q.page;
+                mask=native_pixmaps::get(canvas_.d, *page, true);
+            }
+            if (mask==nullptr) continue;
+            ::XRenderComposite(canvas_.d, PictOpOver, solid, mask->picture, canvas_.picture,
+                0, 0, q.src.x, q.src.y, p.x+q.dst.x, p.y+q.dst.y, q.src.w, q.src.h);
+        }
+        ::XRenderFreePicture(canvas_.d, solid);
+    }
 //{{END.DEF}}
 }
\ No newline at end of file
@@ -0,0 +1,69 @@
+//
+// native_batch.cpp
+// 
+// Batched X11 primitives implementation.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    void native_batch::fill_rect(const canvas& c, unsigned long pixel, rct r) {
+        prepare(c, pixel, kind::fill);
+        rects_.push_back({ 
+            (short)r.x, (short)r.y, (unsigned short)r.w, (unsigned short)r.h });
+    }
+
+    void native_batch::draw_rect(const canvas& c, unsigned long pixel, rct r) {
+        prepare(c, pixel, kind::rect);
+        // X11 outline is one pixel wider and higher than the rectangle.
+        rects_.push_back({ 
+            (short)r.x, (short)r.y, (unsigned short)(r.w-1), (unsigned short)(r.h-1) });
+    }
+
+    void native_batch::draw_line(const canvas& c, unsigned long pixel, pt p1, pt p2) {
+        prepare(c, pixel, kind::line);
+        segments_.push_back({ (short)p1.x, (short)p1.y, (short)p2.x, (short)p2.y });
+    }
+
+    void native_batch::prepare(const canvas& c, unsigned long pixel, kind k) {
+        if (c.d!=display_ || c.w!=drawable_ || c.gc!=gc_) {
+            flush();
+            display_=c.d; drawable_=c.w; 
+            // New gc, unknown foreground.
+            if (c.gc!=gc_) { gc_=c.gc; has_pixel_=false; }
+        } else if (k!=kind_ || (has_pixel_ && pixel!=pixel_))
+            flush();
+        kind_=k;
+        if (!has_pixel_ || pixel!=pixel_) {
+            ::XSetForeground(display_, gc_, pixel);
+            pixel_=pixel; has_pixel_=true;
+        }
+    }
+
+    void native_batch::flush() {
+        switch (kind_) {
+        case kind::fill:
+            ::XFillRectangles(display_, drawable_, gc_, rects_.data(), rects_.size());
+            break;
+        case kind::rect:
+            ::XDrawRectangles(display_, drawable_, gc_, rects_.data(), rects_.size());
+            break;
+        case kind::line:
+            ::XDrawSegments(display_, drawable_, gc_, segments_.data(), segments_.size());
+            break;
+        case kind::none:
+            break;
+        }
+        rects_.clear();
+        segments_.clear();
+        kind_=kind::none;
+    }
+//{{END.DEF}}
+
+} // namespace nice
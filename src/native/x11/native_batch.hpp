@@ -0,0 +1,49 @@
+//
+// native_batch.hpp
+// 
+// Collects X11 primitives of the same kind and color, and sends
+// them as one request (XFillRectangles, XDrawRectangles or 
+// XDrawSegments). Batch is flushed when the kind, color or target
+// changes, before rasters are drawn, and at the end of paint.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _NATIVE_BATCH_HPP
+#define _NATIVE_BATCH_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    class native_batch {
+    public:
+        native_batch() {}
+        virtual ~native_batch() {}
+        // Queue primitives.
+        void fill_rect(const canvas& c, unsigned long pixel, rct r);
+        void draw_rect(const canvas& c, unsigned long pixel, rct r);
+        void draw_line(const canvas& c, unsigned long pixel, pt p1, pt p2);
+        // Send queued primitives to server.
+        void flush();
+    private:
+        enum class kind { none, fill, rect, line };
+        // Flush if anything but coordinates changes.
+        void prepare(const canvas& c, unsigned long pixel, kind k);
+        Display* display_ {nullptr};
+        Drawable drawable_ {0};
+        GC gc_ {0};
+        kind kind_ {kind::none};
+        // Foreground of gc_, to skip redundant XSetForeground.
+        unsigned long pixel_ {0};
+        bool has_pixel_ {false};
+        // Queued primitives (kept between paints to reuse memory).
+        std::vector<XRectangle> rects_;
+        std::vector<XSegment> segments_;
+    };
+//{{END.DEC}}
+
+} // namespace nice
+
+#endif // _NATIVE_BATCH_HPP
@@ -0,0 +1,74 @@
+//
+// native_colors.cpp
+// 
+// Color to pixel resolver implementation for X11.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    // Static variable.
+    std::map<Display*, std::unique_ptr<native_colors>> native_colors::instances_;
+
+    native_colors::native_colors(Display* d) {
+        display_=d;
+        int s=DefaultScreen(d);
+        cmap_=DefaultColormap(d, s);
+        Visual* v=DefaultVisual(d, s);
+        true_color_ = v->c_class==TrueColor || v->c_class==DirectColor;
+        unsigned long masks[] = { v->red_mask, v->green_mask, v->blue_mask };
+        for (int i=0; i<3; i++) {
+            shift_[i]= masks[i] ? std::countr_zero(masks[i]) : 0;
+            mask_[i]=masks[i] >> shift_[i];
+        }
+    }
+
+    native_colors::~native_colors() {
+        if (cache_.empty()) return;
+        std::vector<unsigned long> pixels;
+        for (auto const& c : cache_) pixels.push_back(c.second);
+        ::XFreeColors(display_, cmap_, pixels.data(), pixels.size(), 0);
+    }
+
+    unsigned long native_colors::pixel(color c) {
+        if (true_color_) {
+            // Scale each channel to its mask.
+            byte rgb[] = { c.r, c.g, c.b };
+            unsigned long p=0;
+            for (int i=0; i<3; i++) 
+                p |= (rgb[i] * mask_[i] / 0xff) << shift_[i];
+            return p;
+        }
+        uint32_t key = (c.r << 16) | (c.g << 8) | c.b;
+        auto it=cache_.find(key);
+        if (it!=cache_.end()) return it->second;
+        // Round trip, but only once per color.
+        XColor xc;
+        xc.red=c.r * 0x101; 
+        xc.green=c.g * 0x101; 
+        xc.blue=c.b * 0x101;
+        xc.flags = DoRed | DoGreen | DoBlue;
+        if (!::XAllocColor(display_, cmap_, &xc)) 
+            return BlackPixel(display_, DefaultScreen(display_));
+        cache_[key]=xc.pixel;
+        return xc.pixel;
+    }
+
+    native_colors& native_colors::of(Display* d) {
+        auto& nc=instances_[d];
+        if (!nc) nc=std::make_unique<native_colors>(d);
+        return *nc;
+    }
+
+    void native_colors::release(Display* d) {
+        instances_.erase(d);
+    }
+//{{END.DEF}}
+
+} // namespace nice
@@ -0,0 +1,46 @@
+//
+// native_colors.hpp
+// 
+// Resolve colors to X11 pixel values. On TrueColor and DirectColor 
+// visuals the pixel is computed from channel masks, other visuals 
+// allocate colormap entries once and cache them.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _NATIVE_COLORS_HPP
+#define _NATIVE_COLORS_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    class native_colors {
+    public:
+        // Resolver for the default visual of display.
+        native_colors(Display* d);
+        // Frees allocated colormap entries.
+        virtual ~native_colors();
+        // Pixel value of color (alpha is ignored).
+        unsigned long pixel(color c);
+        // Resolver of display, created on first use.
+        static native_colors& of(Display* d);
+        // Destroy resolver before closing display.
+        static void release(Display* d);
+    private:
+        Display* display_;
+        Colormap cmap_;
+        // Fast path.
+        bool true_color_;
+        unsigned long mask_[3];
+        int shift_[3];
+        // Allocated colors, by rgb.
+        std::unordered_map<uint32_t, unsigned long> cache_;
+        static std::map<Display*, std::unique_ptr<native_colors>> instances_;
+    };
+//{{END.DEC}}
+
+} // namespace nice
+
+#endif // _NATIVE_COLORS_HPP
@@ -17,9 +17,17 @@ extern "C" {
 #include <stdint.h>
 #include <fcntl.h>
 #include <sys/file.h>
+#include <poll.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
 
 #include <X11/Xlib.h>
 #include <X11/Xutil.h>
 #include <X11/Xos.h>
+#include <X11/extensions/XShm.h>
+#include <X11/extensions/Xrender.h>
+#ifdef __XRANDR__
+#include <X11/extensions/Xrandr.h>
+#endif
 }
 //{{END.INC}}
\ No newline at end of file
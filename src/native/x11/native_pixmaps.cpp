@@ -0,0 +1,96 @@
+//
+// native_pixmaps.cpp
+// 
+// Raster pixmap cache implementation.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    // Static variable.
+    lru_cache<native_pixmaps::key, native_pixmaps::pixmap, native_pixmaps::key_hash> 
+        native_pixmaps::cache_(64*1024*1024);
+    std::map<Display*, native_pixmaps::scratch_s> native_pixmaps::scratch_;
+
+    native_pixmaps::pixmap::pixmap(pixmap&& o) 
+        : display(o.display), pix(o.pix), gc(o.gc), picture(o.picture), 
+          generation(o.generation) {
+        o.pix=0; o.gc=0; o.picture=0;
+    }
+
+    native_pixmaps::pixmap::~pixmap() {
+        if (picture!=0) ::XRenderFreePicture(display, picture);
+        if (gc!=0) ::XFreeGC(display, gc);
+        if (pix!=0) ::XFreePixmap(display, pix);
+    }
+
+    native_pixmaps::pixmap* native_pixmaps::get(Display* d, const raster& rst, bool argb) {
+        key k { d, rst.id(), argb };
+        pixmap* p=cache_.find(k);
+        // Static raster, already there?
+        if (p!=nullptr && rst.keep_uploaded() && p->generation==rst.generation()) 
+            return p;
+        native_raster* nr=rst.native();
+        XImage* img=argb ? nr->argb_image(d) : nr->image(d);
+        if (img==nullptr) return nullptr;
+        // Static raster, changed? Upload only what changed.
+        rct up { 0, 0, rst.width(), rst.height() };
+        if (p!=nullptr && rst.keep_uploaded()) up=rst.changed_since(p->generation);
+        if (p==nullptr) {
+            if (argb && native_xrender::of(d)==nullptr) return nullptr;
+            p=&cache_.insert(k, create(d, rst.width(), rst.height(), argb), 
+                4 * rst.width() * rst.height());
+            nr->uploaded(rst.id());
+        }
+        // Upload.
+        nr->put(d, p->pix, p->gc, img, up, { up.x, up.y });
+        p->generation=rst.generation();
+        return p;
+    }
+
+    native_pixmaps::pixmap* native_pixmaps::scratch(Display* d, int w, int h) {
+        if (native_xrender::of(d)==nullptr) return nullptr;
+        scratch_s& s=scratch_[d];
+        if (s.pix==nullptr || s.sz.w<w || s.sz.h<h) {
+            // Grow, never shrink.
+            s.sz={ std::max(s.sz.w, w), std::max(s.sz.h, h) };
+            s.pix.reset();
+            s.pix=std::make_unique<pixmap>(create(d, s.sz.w, s.sz.h, true));
+        }
+        return s.pix.get();
+    }
+
+    native_pixmaps::pixmap native_pixmaps::create(Display* d, int w, int h, bool argb) {
+        int depth=argb ? 32 : DefaultDepth(d, DefaultScreen(d));
+        Pixmap pix=::XCreatePixmap(d, DefaultRootWindow(d), w, h, depth);
+        // Own gc, window gc is clipped.
+        GC gc=::XCreateGC(d, pix, 0, NULL);
+        Picture pic=0;
+        if (argb) {
+            XRenderPictureAttributes pa{};
+            pic=::XRenderCreatePicture(d, pix, native_xrender::of(d)->argb32(), 0, &pa);
+        }
+        return pixmap(d, pix, gc, pic);
+    }
+
+    void native_pixmaps::release(Display* d) {
+        cache_.erase_if([d](const key& k) { return k.d==d; });
+        scratch_.erase(d);
+    }
+
+    void native_pixmaps::forget(uint64_t id) {
+        cache_.erase_if([id](const key& k) { return k.id==id; });
+    }
+
+    void native_pixmaps::budget(size_t bytes) {
+        cache_.budget(bytes);
+    }
+//{{END.DEF}}
+
+} // namespace nice
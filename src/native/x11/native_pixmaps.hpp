@@ -0,0 +1,75 @@
+//
+// native_pixmaps.hpp
+// 
+// Server side copies (pixmaps) of rasters. Rasters marked with 
+// keep_uploaded() are uploaded once and then drawn with server 
+// local copies, until their generation changes. Premultiplied 
+// rasters also live here as ARGB pixmaps for XRender. Least 
+// recently used pixmaps are freed above the memory budget.
+// Rasters drawn once go through one scratch pixmap instead.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _NATIVE_PIXMAPS_HPP
+#define _NATIVE_PIXMAPS_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    class native_pixmaps {
+    public:
+        // Server copy of raster.
+        struct pixmap {
+            pixmap(Display* d, Pixmap p, GC gc, Picture pic) 
+                : display(d), pix(p), gc(gc), picture(pic) {}
+            pixmap(pixmap&& o);
+            ~pixmap();
+            Display* display;
+            Pixmap pix;
+            GC gc;
+            Picture picture; // ARGB pixmaps only.
+            uint64_t generation {0};
+        };
+        // Pixmap with current pixels of raster. ARGB pixmap (32 bit,
+        // with picture) needs XRender, the other has default depth.
+        static pixmap* get(Display* d, const raster& rst, bool argb);
+        // Scratch ARGB pixmap of display, at least w x h, for rasters
+        // drawn once. Not cached, it grows and stays until release.
+        static pixmap* scratch(Display* d, int w, int h);
+        // Free pixmaps of display (before closing it).
+        static void release(Display* d);
+        // Free pixmaps of raster (when raster is destroyed).
+        static void forget(uint64_t id);
+        // Memory budget in bytes (default 64MB).
+        static void budget(size_t bytes);
+    private:
+        struct key {
+            Display* d;
+            uint64_t id;
+            bool argb;
+            bool operator==(const key& o) const { 
+                return d==o.d && id==o.id && argb==o.argb; 
+            }
+        };
+        struct key_hash {
+            size_t operator()(const key& k) const {
+                return std::hash<void*>()(k.d) ^ std::hash<uint64_t>()(k.id*2+k.argb);
+            }
+        };
+        static lru_cache<key, pixmap, key_hash> cache_;
+        struct scratch_s {
+            size sz;
+            std::unique_ptr<pixmap> pix;
+        };
+        static std::map<Display*, scratch_s> scratch_;
+        // New pixmap, ARGB ones with picture (needs XRender).
+        static pixmap create(Display* d, int w, int h, bool argb);
+    };
+//{{END.DEC}}
+
+} // namespace nice
+
+#endif // _NATIVE_PIXMAPS_HPP
@@ -2,6 +2,10 @@
 // native_raster.cpp
 // 
 // Native raster (X11) format (for easy blitting).
+// When the display is local and supports the MIT-SHM extension,
+// large rasters are put through a shared memory segment. Pixels 
+// are copied to it, and the server reads them with XShmPutImage 
+// instead of through the socket.
 // 
 // (c) 2021 Tomaz Stih
 // This code is licensed under MIT license (see LICENSE.txt for details).
@@ -29,8 +33,30 @@ namespace nice {
         raw_=std::make_unique<uint8_t[]>(len_);
     }  
 
-    native_raster::~native_raster() {
+    // Destroy image, but not the pixels it points to.
+    static void x11_destroy_image(XImage* img) {
+        if (img==nullptr) return;
+        img->data=NULL;
+        XDestroyImage(img);
+    }
 
+    native_raster::~native_raster() {
+        // Free server copies.
+        if (uploaded_!=0) native_pixmaps::forget(uploaded_);
+        for(auto& i : images_) {
+            x11_destroy_image(i.argb);
+            x11_destroy_image(i.image);
+        }
+        x11_destroy_image(shm_image_);
+        x11_destroy_image(shm_argb_);
+        if (shm_display_!=nullptr) {
+            // Detach only if display is still open. The server
+            // detaches itself when the connection is closed. It
+            // reads pending puts before that.
+            if (app::instance().display==shm_display_)
+                ::XShmDetach(shm_display_, &shm_);
+            ::shmdt(shm_.shmaddr);
+        }
     }
 
     int native_raster::width() const {
@@ -44,6 +70,143 @@ namespace nice {
     uint8_t* native_raster::raw() const {
         return raw_.get();
     }
+
+    void native_raster::uploaded(uint64_t id) {
+        uploaded_=id;
+    }
+
+    native_raster::images_s* native_raster::find(Display* d) {
+        for(auto& i : images_)
+            if (i.d==d) return &i;
+        return nullptr;
+    }
+
+    XImage* native_raster::image(Display* d) {
+        // Cached?
+        images_s* i=find(d);
+        if (i!=nullptr) return i->image;
+        XImage* img=::XCreateImage(
+            d, 
+            DefaultVisual(d, DefaultScreen(d)), 
+            24, 
+            ZPixmap, 
+            0, 
+            (char*)raw_.get(),
+            width_,
+            height_,
+            32,
+            0);
+        if (img!=nullptr) images_.push_back({d, img, nullptr});
+        return img;
+    }
+
+    XImage* native_raster::argb_image(Display* d) {
+        if (image(d)==nullptr) return nullptr;
+        images_s* i=find(d);
+        if (i->argb==nullptr) 
+            // Same pixels, viewed as 32 bit deep image.
+            i->argb=::XCreateImage(d, DefaultVisual(d, DefaultScreen(d)), 32, ZPixmap, 
+                0, (char*)raw_.get(), width_, height_, 32, 0);
+        return i->argb;
+    }
+
+    void native_raster::put(Display* d, Drawable dr, GC gc, XImage* img, rct src, pt dst) {
+        XImage* si=len_>=shm_min_bytes && share(d) ? shm_image(d, img->depth) : nullptr;
+        if (si==nullptr) {
+            ::XPutImage(d, dr, gc, img, src.x, src.y, dst.x, dst.y, src.w, src.h);
+            return;
+        }
+        // Server may still be reading the segment.
+        wait_puts();
+        for (int y=src.y; y<src.y+src.h; y++) {
+            size_t at=4*((size_t)y*width_+src.x);
+            std::memcpy(shm_.shmaddr+at, raw_.get()+at, 4*src.w);
+        }
+        // Server reads the segment later, and sends a completion 
+        // event when done.
+        pending_=NextRequest(d);
+        ::XShmPutImage(d, dr, gc, si, src.x, src.y, dst.x, dst.y, src.w, src.h, True);
+    }
+
+    // Completion event of a put from segment, at or after serial.
+    struct shm_wait_s { int type; ShmSeg seg; unsigned long serial; };
+    static Bool is_completion(Display *, XEvent *e, XPointer arg) {
+        auto w=(shm_wait_s*)arg;
+        return e->type==w->type 
+            && ((XShmCompletionEvent*)e)->shmseg==w->seg 
+            && e->xany.serial>=w->serial;
+    }
+
+    void native_raster::wait_puts() {
+        Display* d=shm_display_;
+        // Requests are processed in order, so any event or reply after 
+        // the put means it is done. The event loop drops completions.
+        if (pending_!=0 && LastKnownRequestProcessed(d)<pending_) {
+            shm_wait_s w { ::XShmGetEventBase(d)+ShmCompletion, shm_.shmseg, pending_ };
+            XEvent e;
+            ::XIfEvent(d, &e, is_completion, (XPointer)&w);
+        }
+        pending_=0;
+    }
+
+    XImage* native_raster::shm_image(Display* d, int depth) {
+        XImage*& img=depth==32 ? shm_argb_ : shm_image_;
+        if (img==nullptr) {
+            // The server decides on the layout, ours must match.
+            img=::XShmCreateImage(d, DefaultVisual(d, DefaultScreen(d)), depth, 
+                ZPixmap, shm_.shmaddr, &shm_, width_, height_);
+            if (img!=nullptr && (img->bytes_per_line!=width_*4 || img->bits_per_pixel!=32)) {
+                x11_destroy_image(img);
+                img=nullptr;
+            }
+        }
+        return img;
+    }
+
+    // Set by X error handler when XShmAttach fails.
+    static bool shm_failed_;
+    static int shm_error_handler(Display *, XErrorEvent *) {
+        shm_failed_=true;
+        return 0;
+    }
+
+    bool native_raster::share(Display* d) {
+        if (shm_tried_) return d==shm_display_;
+        shm_tried_=true;
+        // Only local connections can share memory.
+        std::string dname=DisplayString(d);
+        if (dname.empty() || (dname[0]!=':' && dname.rfind("unix:",0)!=0))
+            return false;
+        if (!::XShmQueryExtension(d)) 
+            return false;
+
+        // Allocate segment.
+        shm_.shmid=::shmget(IPC_PRIVATE, len_, IPC_CREAT|0600);
+        if (shm_.shmid<0) return false;
+        void* addr=::shmat(shm_.shmid, 0, 0);
+        if (addr==(void*)-1) {
+            ::shmctl(shm_.shmid, IPC_RMID, 0);
+            return false;
+        }
+        shm_.shmaddr=(char*)addr;
+        shm_.readOnly=True;
+
+        // Attach fails asynchronously (i.e. remote server), so trap errors.
+        shm_failed_=false;
+        auto handler=::XSetErrorHandler(shm_error_handler);
+        ::XShmAttach(d, &shm_);
+        ::XSync(d, False);
+        ::XSetErrorHandler(handler);
+        // Segment is destroyed after last detach.
+        ::shmctl(shm_.shmid, IPC_RMID, 0);
+        if (shm_failed_) {
+            ::shmdt(shm_.shmaddr);
+            shm_.shmaddr=nullptr;
+            return false;
+        }
+        shm_display_=d;
+        return true;
+    }
 //{{END.DEF}}
 
-}
\ No newline at end of file
+}
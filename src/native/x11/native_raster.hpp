@@ -13,6 +13,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace nice {
 
@@ -30,9 +31,47 @@ namespace nice {
         int height() const;
         // Pointer to raw data.
         uint8_t* raw() const;
+        // XImage wrapping raw data, one per display.
+        XImage* image(Display* d);
+        // Same raw data as 32 bit deep image (for ARGB pixmaps).
+        XImage* argb_image(Display* d);
+        // Raster id of uploaded pixmaps, they are freed with us.
+        void uploaded(uint64_t id);
+        // Put part of image (of this raster) to drawable. Large rasters
+        // are copied to a shared memory segment (MIT-SHM) of the first 
+        // display they are put to, and the server reads them from there.
+        // UI thread only.
+        void put(Display* d, Drawable dr, GC gc, XImage* img, rct src, pt dst);
+        // Smaller rasters are not worth a segment.
+        static constexpr int shm_min_bytes=64*1024;
     private:
         int width_, height_, len_;
         std::unique_ptr<uint8_t[]> raw_; // We own this!
+        // Cached images per display.
+        struct images_s {
+            Display* d;
+            XImage* image;
+            XImage* argb;
+        };
+        std::vector<images_s> images_;
+        // Shared memory segment, attached to one display only, and
+        // images over it.
+        Display* shm_display_ {nullptr};
+        XShmSegmentInfo shm_ {0, -1, nullptr, False};
+        bool shm_tried_ {false};
+        XImage* shm_image_ {nullptr};
+        XImage* shm_argb_ {nullptr};
+        // Request serial of last put from the segment, 0 if none.
+        unsigned long pending_ {0};
+        uint64_t uploaded_ {0};
+        // Cached images of the display (or nullptr).
+        images_s* find(Display* d);
+        // Create segment and attach it to display, once.
+        bool share(Display* d);
+        // Segment image of depth (or nullptr).
+        XImage* shm_image(Display* d, int depth);
+        // Wait for the completion event of the last put.
+        void wait_puts();
     };
 //{{END.DEC}}
 
@@ -17,6 +17,10 @@ int main(int argc, char* argv[]) {
     // X Windows initialization code.
     nice::app_instance inst;
     inst.display=::XOpenDisplay(NULL);
+    // Other threads wake event loop through this pipe.
+    if (::pipe(inst.wake)<0)
+        throw_ex(nice::nice_exception,"Unable to create wake pipe.");
+    for (int fd : inst.wake) ::fcntl(fd, F_SETFL, O_NONBLOCK);
     nice::app::instance(inst);
 
     // Copy cmd line arguments.
@@ -30,7 +34,13 @@ int main(int argc, char* argv[]) {
     program();
     
     // Close display.
+    nice::native_colors::release(inst.display);
+    nice::native_pixmaps::release(inst.display);
+    nice::native_xrender::release(inst.display);
     ::XCloseDisplay(inst.display);
+    inst.display=nullptr;
+    nice::app::instance(inst);
+    ::close(inst.wake[0]); ::close(inst.wake[1]);
 
     // And return return code;
     return nice::app::ret_code;
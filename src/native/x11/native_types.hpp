@@ -22,6 +22,7 @@ namespace nice {
     // Basic X11 stuff.
     typedef struct x11_app_instance {
         Display* display;
+        int wake[2]; // Pipe to wake up event loop.
     } app_instance;
 
     // X11 coordinate.
@@ -31,10 +32,15 @@ namespace nice {
     typedef uint8_t byte;
 
     // X11 GC and required stuff.
+    class native_batch;
     typedef struct x11_canvas {
         Display* d;
         Window w;
         GC gc;
+        native_batch* batch; // Primitive batch, flushed after paint.
+        int width;  // Drawable size.
+        int height;
+        Picture picture; // XRender picture of drawable (or 0).
     } canvas;
 //{{END.TYP}}
 
@@ -19,72 +19,159 @@ namespace nice {
     native_wnd::native_wnd(wnd *window) {
         window_=window;
         display_=app::instance().display;
-        // TODO: pass size.
-        cached_wsize_={0,0}; // Used to recognize resize events.
+        // Used to recognize resize events, derived window sets
+        // both to the size it was created with.
+        cached_wsize_={0,0};
     }
 
     native_wnd::~native_wnd() {
         // And lazy destroy. We could do this in the destroy() function.
         if (cached_gc_!=0) XFreeGC(display_,cached_gc_);
+        free_back();
+        if (picture_!=0) XRenderFreePicture(display_,picture_);
         XDestroyWindow(display_, winst_); winst_=0;
     }
 
+    void native_wnd::free_back() {
+        if (back_picture_!=0) { XRenderFreePicture(display_,back_picture_); back_picture_=0; }
+        if (back_!=0) { XFreePixmap(display_,back_); back_=0; }
+    }
+
     void native_wnd::destroy() {
         // Remove me from windows map.
         wmap_.erase (winst_); 
     }
 
     void native_wnd::repaint() {
-        XClearArea(display_, winst_, 0, 0, 1, 1, true);
+        // Zero width and height mean whole window.
+        XClearArea(display_, winst_, 0, 0, 0, 0, true);
+    }
+
+    void native_wnd::invalidate(rct r) {
+        // Server clears the area and sends us expose.
+        if (!region::empty(r))
+            XClearArea(display_, winst_, r.x, r.y, r.w, r.h, true);
+    }
+
+    void native_wnd::update() {
+        // Size change?
+        if (configured_wsize_.w!=cached_wsize_.w || configured_wsize_.h!=cached_wsize_.h) {
+            cached_wsize_=configured_wsize_;
+            // Back buffer is recreated on next paint.
+            free_back();
+            window_->resized.emit({cached_wsize_.w,cached_wsize_.h});
+        }
+        if (dirty_.empty()) return;
+        // Need to create the gc?
+        if (cached_gc_==0)
+            cached_gc_= XCreateGC(display_, winst_, 0, NULL); 
+        // Paint to back buffer?
+        Drawable target=winst_;
+        if (double_buffered_ && cached_wsize_.w>0 && cached_wsize_.h>0) {
+            if (back_==0) {
+                back_=XCreatePixmap(display_, winst_, 
+                    cached_wsize_.w, cached_wsize_.h, 
+                    DefaultDepth(display_, DefaultScreen(display_)));
+                // New buffer has no content.
+                dirty_.add({ 0, 0, cached_wsize_.w, cached_wsize_.h });
+            }
+            target=back_;
+        }
+        // Clip to damaged area.
+        std::vector<XRectangle> xrects;
+        for (auto const& r : dirty_.rects())
+            xrects.push_back({ 
+                (short)r.x, (short)r.y, (unsigned short)r.w, (unsigned short)r.h });
+        XSetClipRectangles(display_, cached_gc_, 0, 0, 
+            xrects.data(), xrects.size(), Unsorted);
+        // Server side compositing?
+        Picture pic=0;
+        if (native_xrender* xr=native_xrender::of(display_)) {
+            Picture& p = (target==back_) ? back_picture_ : picture_;
+            if (p==0) p=xr->create_picture(target);
+            XRenderSetPictureClipRectangles(display_, p, 0, 0, 
+                xrects.data(), xrects.size());
+            pic=p;
+        }
+        canvas c { 
+            display_, target, cached_gc_, &batch_, 
+            cached_wsize_.w, cached_wsize_.h, pic };
+        artist a(c, dirty_);
+        window_->paint_to(a);
+        batch_.flush();
+        // One (clipped) copy to window.
+        if (target==back_)
+            XCopyArea(display_, back_, winst_, cached_gc_, 
+                0, 0, cached_wsize_.w, cached_wsize_.h, 0, 0);
+        XSetClipMask(display_, cached_gc_, None);
+        dirty_.clear();
     }
 
     void native_wnd::set_title(std::string s) {
         ::XStoreName(display_, winst_, s.c_str());
+        title_=s;
     };
      
     std::string native_wnd::get_title() {
-        char * name;
-        ::XFetchName(display_,winst_, &name);
-        std::string wname=name;
-        ::XFree(name);
-        return wname;
+        return title_;
     }
 
     size native_wnd::get_wsize() {
-        XWindowAttributes wattr;
-        ::XGetWindowAttributes(display_,winst_,&wattr);
         // TODO: I think this is just the client area?
-        return { wattr.width, wattr.height };
+        return { geometry_.w, geometry_.h };
     }
 
     void native_wnd::set_wsize(size sz) {
         XResizeWindow(display_,winst_, sz.w, sz.h);
+        // Window manager may disagree, configure event will tell.
+        geometry_.w=sz.w; geometry_.h=sz.h;
     }
 
     pt native_wnd::get_location() {
-        XWindowAttributes wattr;
-        ::XGetWindowAttributes(display_,winst_,&wattr);
         // TODO: I think this is just the client area?
-        return { wattr.x, wattr.y };
+        return { geometry_.x, geometry_.y };
     }
 
     void native_wnd::set_location(pt location) {
         XMoveWindow(display_,winst_, location.left, location.top);
+        geometry_.x=location.left; geometry_.y=location.top;
     }
 
-    // TODO: Implement.
     rct native_wnd::get_paint_area() {
-        XWindowAttributes wattr;
-        ::XGetWindowAttributes(display_,winst_,&wattr);
-        return { 0, 0, wattr.width, wattr.height };
+        return { 0, 0, geometry_.w, geometry_.h };
+    }
+
+    bool native_wnd::get_double_buffered() {
+        return double_buffered_;
+    }
+
+    void native_wnd::set_double_buffered(bool db) {
+        double_buffered_=db;
+        // Server must not clear the window before expose, we paint it all.
+        if (db) 
+            XSetWindowBackgroundPixmap(display_, winst_, None);
+        else {
+            XSetWindowBackground(display_, winst_, 
+                WhitePixel(display_, DefaultScreen(display_)));
+            free_back();
+        }
     }
 
     // Static (global) window proc. For all classes -
     // Remaps the call to local window proc.
     bool native_wnd::global_wnd_proc(const XEvent& e) {
         Window xw = e.xany.window;
-        native_wnd* nw = wmap_[xw];
-        return nw->local_wnd_proc(e);
+        // Late events for destroyed windows are possible.
+        auto it = wmap_.find(xw);
+        if (it==wmap_.end()) return false;
+        return it->second->local_wnd_proc(e);
+    }
+
+    void native_wnd::global_update() {
+        // Copy, because handlers can destroy windows.
+        auto wmap=wmap_;
+        for(auto const& w : wmap)
+            w.second->update();
     }
 
     // Local (per window) window proc.
@@ -107,12 +194,9 @@ namespace nice {
             break;
         case Expose:
             {
-                // Need to create the gc?
-                if (cached_gc_==0)
-                    cached_gc_= XCreateGC(display_, winst_, 0, NULL); 
-                canvas c { display_, winst_, cached_gc_};
-                artist a(c);
-                window_->paint.emit(a);
+                // Collect damage, paint in update().
+                dirty_.add({ 
+                    e.xexpose.x, e.xexpose.y, e.xexpose.width, e.xexpose.height });
             }
 		    break;
         case ButtonPress: // https://tronche.com/gui/x/xlib/events/keyboard-pointer/keyboard-pointer.html
@@ -126,6 +210,8 @@ namespace nice {
                 (bool)(e.xbutton.state&ControlMask),
                 (bool)(e.xbutton.state&ShiftMask)
             };
+            // Moves before button.
+            window_->flush_motion();
             if (e.type==ButtonPress)
                 window_->mouse_down.emit(mi);
             else
@@ -142,18 +228,21 @@ namespace nice {
                 (bool)(e.xmotion.state&ControlMask),
                 (bool)(e.xmotion.state&ShiftMask)
             };
-            window_->mouse_move.emit(mi);
+            window_->motion(mi);
             }
             break;
         case ConfigureNotify:
             {
+            // Only the last one counts, resize in update().
             XConfigureEvent xce = e.xconfigure;
-            // Size change?
-            if (xce.width!=cached_wsize_.w || xce.height!=cached_wsize_.h) {
-                cached_wsize_.w=xce.width;
-                cached_wsize_.h=xce.height;
-                window_->resized.emit({xce.width,xce.height});
-            }
+            // Substructure events report children.
+            if (xce.window!=winst_) break;
+            configured_wsize_={ xce.width, xce.height };
+            geometry_.w=xce.width; geometry_.h=xce.height;
+            // Real events are relative to the parent, which is the
+            // window manager's frame. Only synthetic ones, sent by 
+            // the window manager, have root coordinates.
+            if (xce.send_event) { geometry_.x=xce.x; geometry_.y=xce.y; }
             }
             break;
         // TODO: KeyPress, KeyRelease
@@ -29,6 +29,8 @@ namespace nice {
         void destroy(void);
         // Invalidate native window.
         void repaint(void);
+        // Invalidate rectangle.
+        void invalidate(rct r);
         // Get window title.
         std::string get_title();
         // Set window title.
@@ -44,8 +46,13 @@ namespace nice {
         void set_location(pt location);
         // Get window paint rectangle.
         rct get_paint_area();
+        // Get and set double buffering.
+        bool get_double_buffered();
+        void set_double_buffered(bool db);
         // Global window procedure (static)
         static bool global_wnd_proc(const XEvent& e);
+        // Handle collected events of all windows (static).
+        static void global_update();
     protected:
         // X11 window structure.
         Window winst_; 
@@ -59,7 +66,28 @@ namespace nice {
         wnd* window_;
         // Cached size.
         size cached_wsize_;
+        // Window geometry and title, kept on client side so that 
+        // reading properties needs no server round trip. Updated 
+        // by set functions and by configure events.
+        rct geometry_ {0,0,0,0};
+        std::string title_;
         GC cached_gc_ {0};
+        // Back buffer. Created lazily, freed on resize.
+        bool double_buffered_ {false};
+        Pixmap back_ {0};
+        // XRender pictures of window and back buffer.
+        Picture picture_ {0};
+        Picture back_picture_ {0};
+        // Free back buffer (and its picture).
+        void free_back();
+        // Batched primitives.
+        native_batch batch_;
+        // Damaged area, collected from expose events.
+        region dirty_;
+        // Last configured size, collected from configure events.
+        size configured_wsize_ {0,0};
+        // Deliver mouse moves, apply configured size and paint damaged area now.
+        void update();
     };
 //{{END.DEC}}
 
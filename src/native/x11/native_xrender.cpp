@@ -0,0 +1,77 @@
+//
+// native_xrender.cpp
+// 
+// XRender support implementation.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    // Static variable.
+    std::map<Display*, std::unique_ptr<native_xrender>> native_xrender::instances_;
+
+    native_xrender::native_xrender(Display* d) {
+        display_=d;
+        window_format_=::XRenderFindVisualFormat(d, DefaultVisual(d, DefaultScreen(d)));
+        argb32_=::XRenderFindStandardFormat(d, PictStandardARGB32);
+    }
+
+    Picture native_xrender::create_picture(Drawable dr) {
+        XRenderPictureAttributes pa{};
+        return ::XRenderCreatePicture(display_, dr, window_format_, 0, &pa);
+    }
+
+    void native_xrender::composite(int op, Picture src, size src_size, 
+        Picture dst, rct dst_rect, bool smooth) {
+        bool scaled = src_size.w!=dst_rect.w || src_size.h!=dst_rect.h;
+        if (scaled) {
+            // Transform maps destination to source coordinates.
+            XTransform t {{
+                { XDoubleToFixed((double)src_size.w/dst_rect.w), 0, 0 },
+                { 0, XDoubleToFixed((double)src_size.h/dst_rect.h), 0 },
+                { 0, 0, XDoubleToFixed(1) }
+            }};
+            ::XRenderSetPictureTransform(display_, src, &t);
+            ::XRenderSetPictureFilter(display_, src, 
+                smooth ? FilterBilinear : FilterNearest, NULL, 0);
+        }
+        ::XRenderComposite(display_, op, src, None, dst, 
+            0, 0, 0, 0, dst_rect.x, dst_rect.y, dst_rect.w, dst_rect.h);
+        if (scaled) {
+            XTransform id {{
+                { XDoubleToFixed(1), 0, 0 },
+                { 0, XDoubleToFixed(1), 0 },
+                { 0, 0, XDoubleToFixed(1) }
+            }};
+            ::XRenderSetPictureTransform(display_, src, &id);
+        }
+    }
+
+    native_xrender* native_xrender::of(Display* d) {
+        auto it=instances_.find(d);
+        if (it!=instances_.end()) return it->second.get();
+        // Query once per display.
+        int event_base, error_base;
+        const char* env=::getenv("NICE_XRENDER");
+        bool enabled=(env==nullptr || std::string(env)!="0")
+            && ::XRenderQueryExtension(d, &event_base, &error_base);
+        auto& xr=instances_[d];
+        if (enabled) {
+            xr=std::make_unique<native_xrender>(d);
+            if (xr->window_format_==nullptr || xr->argb32_==nullptr) xr.reset();
+        }
+        return xr.get();
+    }
+
+    void native_xrender::release(Display* d) {
+        instances_.erase(d);
+    }
+//{{END.DEF}}
+
+} // namespace nice
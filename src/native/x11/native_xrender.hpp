@@ -0,0 +1,48 @@
+//
+// native_xrender.hpp
+// 
+// XRender support of a display. Compositing (alpha, scaling) runs
+// in the server. Null when the server has no RENDER extension, or
+// when disabled with NICE_XRENDER=0, and drawing falls back to the
+// core protocol. Then transparent rasters are blended after reading
+// the background back, a round trip per draw, and above 128x128 
+// pixels they get 1 bit transparency instead.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _NATIVE_XRENDER_HPP
+#define _NATIVE_XRENDER_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    class native_xrender {
+    public:
+        native_xrender(Display* d);
+        virtual ~native_xrender() {}
+        // Picture of a drawable with default visual.
+        Picture create_picture(Drawable dr);
+        // ARGB (premultiplied) format, for rasters.
+        XRenderPictFormat* argb32() const { return argb32_; }
+        // Composite whole src (of src_size) to dst rectangle. Scales
+        // when sizes differ, smooth filter uses bilinear filtering.
+        void composite(int op, Picture src, size src_size, 
+            Picture dst, rct dst_rect, bool smooth=true);
+        // XRender of display, nullptr if not available.
+        static native_xrender* of(Display* d);
+        // Destroy before closing display.
+        static void release(Display* d);
+    private:
+        Display* display_;
+        XRenderPictFormat* window_format_;
+        XRenderPictFormat* argb32_;
+        static std::map<Display*, std::unique_ptr<native_xrender>> instances_;
+    };
+//{{END.DEC}}
+
+} // namespace nice
+
+#endif // _NATIVE_XRENDER_HPP
@@ -0,0 +1,207 @@
+//
+// path.cpp
+// 
+// Path flattening and stroking.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    path& path::move_to(float x, float y) {
+        verbs_.push_back(verb::move);
+        points_.push_back({ x, y });
+        return *this;
+    }
+
+    path& path::line_to(float x, float y) {
+        if (verbs_.empty()) return move_to(x, y);
+        verbs_.push_back(verb::line);
+        points_.push_back({ x, y });
+        return *this;
+    }
+
+    path& path::quad_to(float cx, float cy, float x, float y) {
+        if (verbs_.empty()) move_to(cx, cy);
+        verbs_.push_back(verb::quad);
+        points_.push_back({ cx, cy });
+        points_.push_back({ x, y });
+        return *this;
+    }
+
+    path& path::cubic_to(float c1x, float c1y, float c2x, float c2y, float x, float y) {
+        if (verbs_.empty()) move_to(c1x, c1y);
+        verbs_.push_back(verb::cubic);
+        points_.push_back({ c1x, c1y });
+        points_.push_back({ c2x, c2y });
+        points_.push_back({ x, y });
+        return *this;
+    }
+
+    path& path::close() {
+        if (!verbs_.empty() && verbs_.back()!=verb::close) 
+            verbs_.push_back(verb::close);
+        return *this;
+    }
+
+    rct path::bounds() const {
+        if (points_.empty()) return { 0, 0, 0, 0 };
+        float x0=points_[0].x, y0=points_[0].y, x1=x0, y1=y0;
+        for (auto const& p : points_) {
+            x0=std::min(x0, p.x); y0=std::min(y0, p.y);
+            x1=std::max(x1, p.x); y1=std::max(y1, p.y);
+        }
+        coord l=(coord)std::floor(x0), t=(coord)std::floor(y0);
+        return { l, t, (coord)std::ceil(x1)-l, (coord)std::ceil(y1)-t };
+    }
+
+    std::vector<path::contour> path::contours(float tolerance) const {
+        std::vector<contour> result;
+        // Segments needed so that chords deviate less than tolerance,
+        // dd is the largest second derivative on the curve.
+        auto segments=[tolerance](float dd) {
+            float n=std::ceil(std::sqrt(dd / (8.0f * tolerance)));
+            return (int)std::clamp(n, 1.0f, 256.0f);
+        };
+        auto length=[](float x, float y) { return std::sqrt(x*x + y*y); };
+        size_t pi=0;
+        for (auto v : verbs_) {
+            if (v==verb::move) {
+                result.push_back({ { points_[pi++] }, false });
+                continue;
+            }
+            contour& c=result.back();
+            ptf p0=c.pts.back();
+            switch (v) {
+            case verb::line:
+                c.pts.push_back(points_[pi++]);
+                break;
+            case verb::quad: {
+                ptf p1=points_[pi], p2=points_[pi+1];
+                pi+=2;
+                int n=segments(2*length(p0.x-2*p1.x+p2.x, p0.y-2*p1.y+p2.y));
+                for (int i=1; i<=n; i++) {
+                    float t=(float)i/n, u=1-t;
+                    c.pts.push_back({ 
+                        u*u*p0.x + 2*u*t*p1.x + t*t*p2.x,
+                        u*u*p0.y + 2*u*t*p1.y + t*t*p2.y });
+                }
+                break;
+            }
+            case verb::cubic: {
+                ptf p1=points_[pi], p2=points_[pi+1], p3=points_[pi+2];
+                pi+=3;
+                float dd=std::max(
+                    length(p0.x-2*p1.x+p2.x, p0.y-2*p1.y+p2.y),
+                    length(p1.x-2*p2.x+p3.x, p1.y-2*p2.y+p3.y));
+                int n=segments(6*dd);
+                for (int i=1; i<=n; i++) {
+                    float t=(float)i/n, u=1-t;
+                    float a=u*u*u, b=3*u*u*t, d=3*u*t*t, e=t*t*t;
+                    c.pts.push_back({ 
+                        a*p0.x + b*p1.x + d*p2.x + e*p3.x,
+                        a*p0.y + b*p1.y + d*p2.y + e*p3.y });
+                }
+                break;
+            }
+            case verb::close:
+                c.closed=true;
+                // Drawing continues from start.
+                result.push_back({ { c.pts.front() }, false });
+                break;
+            default:
+                break;
+            }
+        }
+        // Drop single points (i.e. move after close).
+        std::erase_if(result, [](const contour& c) { return c.pts.size()<2; });
+        return result;
+    }
+
+    std::vector<polygon> path::flatten(float tolerance) const {
+        std::vector<polygon> polys;
+        for (auto& c : contours(tolerance)) polys.push_back(std::move(c.pts));
+        return polys;
+    }
+
+    std::vector<polygon> path::stroke(float width, float tolerance) const {
+        std::vector<polygon> polys;
+        float hw=width/2;
+        if (hw<=0) return polys;
+        // Arc of a round join is split like a circle of n segments.
+        const float pi=3.14159265f;
+        int n=std::clamp((int)std::ceil(pi / std::acos(std::max(0.0f, 1 - tolerance/hw))), 8, 64);
+        // Left side of pts offset by hw, with round joins. Inner side of 
+        // a turn goes through the vertex, non zero fill covers the loop.
+        auto side=[&](const polygon& pts, bool closed, polygon& out) {
+            size_t m=pts.size(), s=closed ? m : m-1;
+            std::vector<ptf> dir(s), nrm(s);
+            for (size_t i=0; i<s; i++) {
+                ptf a=pts[i], b=pts[(i+1)%m];
+                float dx=b.x-a.x, dy=b.y-a.y, len=std::sqrt(dx*dx + dy*dy);
+                dir[i]={ dx/len, dy/len };
+                nrm[i]={ -dy*hw/len, dx*hw/len };
+            }
+            auto join=[&](ptf v, size_t i0, size_t i1) {
+                ptf n0=nrm[i0], n1=nrm[i1], d0=dir[i0], d1=dir[i1];
+                out.push_back({ v.x+n0.x, v.y+n0.y });
+                // Turns back to the left count as turning back, or 
+                // rounding could leave neither side with an arc.
+                float turn=d1.x*n0.x + d1.y*n0.y;
+                if (turn>1e-3f*hw) {
+                    out.push_back(v);
+                } else if (turn<0 || d0.x*d1.x + d0.y*d1.y<0) {
+                    // Outer side, arc around v ahead of it.
+                    float sweep=std::atan2(n0.x*n1.y - n0.y*n1.x, n0.x*n1.x + n0.y*n1.y);
+                    float h=sweep/2;
+                    if ((n0.x*std::cos(h) - n0.y*std::sin(h))*d0.x 
+                        + (n0.x*std::sin(h) + n0.y*std::cos(h))*d0.y < 0)
+                        sweep+=sweep>0 ? -2*pi : 2*pi;
+                    int k=(int)std::ceil(std::fabs(sweep)/(2*pi)*n);
+                    float a0=std::atan2(n0.y, n0.x);
+                    for (int j=1; j<k; j++) {
+                        float a=a0 + sweep*j/k;
+                        out.push_back({ v.x + hw*std::cos(a), v.y + hw*std::sin(a) });
+                    }
+                }
+                out.push_back({ v.x+n1.x, v.y+n1.y });
+            };
+            if (!closed) out.push_back({ pts[0].x+nrm[0].x, pts[0].y+nrm[0].y });
+            for (size_t i=closed ? 0 : 1; i<(closed ? m : m-1); i++)
+                join(pts[i], (i+s-1)%s, i);
+            if (!closed) out.push_back({ pts[m-1].x+nrm[s-1].x, pts[m-1].y+nrm[s-1].y });
+        };
+        for (auto& c : contours(tolerance)) {
+            // Without repeated points segments have a direction.
+            polygon pts;
+            for (auto const& p : c.pts) 
+                if (pts.empty() || p!=pts.back()) pts.push_back(p);
+            if (c.closed && pts.size()>1 && pts.front()==pts.back()) pts.pop_back();
+            if (pts.size()<2) continue;
+            // One outline, out along the left side and back along the 
+            // right (butt caps), or two rings if closed. Closed line 
+            // turns back at both ends, its left side is all of it.
+            polygon out;
+            side(pts, c.closed, out);
+            if (c.closed && pts.size()==2) {
+                polys.push_back(std::move(out));
+                continue;
+            }
+            std::reverse(pts.begin(), pts.end());
+            if (c.closed) {
+                polys.push_back(std::move(out));
+                out.clear();
+            }
+            side(pts, c.closed, out);
+            polys.push_back(std::move(out));
+        }
+        return polys;
+    }
+//{{END.DEF}}
+
+} // namespace nice
@@ -0,0 +1,68 @@
+//
+// path.hpp
+// 
+// Vector paths: lines, quadratic and cubic Bezier curves. Paths
+// are flattened to polygons before rasterization.
+//
+//   path p;
+//   p.move_to(10, 10).line_to(90, 10).quad_to(90, 90, 10, 90).close();
+//   a.fill_path({ 0, 128, 255 }, p);
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _PATH_HPP
+#define _PATH_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    typedef struct ptf_s {
+        float x;
+        float y;
+        bool operator==(const ptf_s&) const = default;
+    } ptf;
+
+    // Closed polygon (last point connects to first).
+    typedef std::vector<ptf> polygon;
+
+    // Which areas of self intersecting or nested polygons are inside.
+    enum class fill_rule : uint8_t { non_zero, even_odd };
+
+    class path {
+    public:
+        // Start new subpath.
+        path& move_to(float x, float y);
+        path& line_to(float x, float y);
+        // Quadratic Bezier with control point (cx, cy).
+        path& quad_to(float cx, float cy, float x, float y);
+        // Cubic Bezier with control points (c1x, c1y) and (c2x, c2y).
+        path& cubic_to(float c1x, float c1y, float c2x, float c2y, float x, float y);
+        // Connect to start of subpath.
+        path& close();
+        void clear() { verbs_.clear(); points_.clear(); }
+        bool empty() const { return verbs_.empty(); }
+        // Bounds of all points (including control points).
+        rct bounds() const;
+        // Polygons, one per subpath, curves are flattened until they 
+        // deviate less than tolerance pixels.
+        std::vector<polygon> flatten(float tolerance=0.25f) const;
+        // Outline of path stroked with width, round joins and butt caps.
+        // One polygon per open subpath, two rings per closed one, fill 
+        // them with non zero rule.
+        std::vector<polygon> stroke(float width, float tolerance=0.25f) const;
+        bool operator==(const path&) const = default;
+    private:
+        enum class verb : uint8_t { move, line, quad, cubic, close };
+        struct contour { polygon pts; bool closed; };
+        std::vector<contour> contours(float tolerance) const;
+        std::vector<verb> verbs_;
+        std::vector<ptf> points_;
+    };
+//{{END.DEC}}
+
+} // namespace nice
+
+#endif // _PATH_HPP
@@ -0,0 +1,63 @@
+//
+// post_queue.cpp
+// 
+// Post queue implementation.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+//{{BEGIN.DEF}}
+    post_queue::~post_queue() {
+        std::function<void()> fn;
+        while (pop(fn));
+    }
+
+    void post_queue::push(node* n) {
+        n->next.store(nullptr, std::memory_order_relaxed);
+        node* prev=head_.exchange(n, std::memory_order_acq_rel);
+        prev->next.store(n, std::memory_order_release);
+    }
+
+    bool post_queue::push(std::function<void()> fn) {
+        node* n=new node;
+        n->fn=std::move(fn);
+        push(n);
+        // Only the first push after consumer woke up signals.
+        return !signaled_.exchange(true, std::memory_order_acq_rel);
+    }
+
+    bool post_queue::pop(std::function<void()>& fn) {
+        node* tail=tail_;
+        node* next=tail->next.load(std::memory_order_acquire);
+        // Skip the stub.
+        if (tail==&stub_) {
+            if (next==nullptr) return false;
+            tail_=tail=next;
+            next=next->next.load(std::memory_order_acquire);
+        }
+        if (next!=nullptr) {
+            tail_=next;
+            fn=std::move(tail->fn);
+            delete tail;
+            return true;
+        }
+        // Last node. A producer may be in the middle of a push.
+        if (tail!=head_.load(std::memory_order_acquire)) return false;
+        // Put stub back behind the last node, so we can take it.
+        push(&stub_);
+        next=tail->next.load(std::memory_order_acquire);
+        if (next!=nullptr) {
+            tail_=next;
+            fn=std::move(tail->fn);
+            delete tail;
+            return true;
+        }
+        return false;
+    }
+//{{END.DEF}}
+}
@@ -0,0 +1,47 @@
+//
+// post_queue.hpp
+// 
+// Lock-free multiple producer, single consumer queue of work 
+// for the event loop thread. Intrusive linked list with a stub 
+// node (D. Vyukov). Producers never block, one atomic exchange per 
+// push. Only the event loop thread may pop.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _POST_QUEUE_HPP
+#define _POST_QUEUE_HPP
+
+#include "includes.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    class post_queue {
+    public:
+        post_queue() : head_(&stub_), tail_(&stub_) {}
+        ~post_queue();
+        // Add work (any thread). Returns true if consumer needs a wake up.
+        bool push(std::function<void()> fn);
+        // Take work (event loop thread only). False if empty.
+        bool pop(std::function<void()>& fn);
+        // Consumer is awake and about to drain the queue.
+        void awake() { signaled_.store(false, std::memory_order_release); }
+    private:
+        struct node {
+            std::atomic<node*> next { nullptr };
+            std::function<void()> fn;
+        };
+        void push(node* n);
+        node stub_;
+        std::atomic<node*> head_; // Producers push here.
+        node* tail_; // Consumer pops here.
+        std::atomic<bool> signaled_ { false };
+    };
+//{{END.DEC}}
+
+}
+
+#endif // _POST_QUEUE_HPP
@@ -0,0 +1,53 @@
+//
+// raster.cpp
+// 
+// Raster mipmaps.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    const raster& raster::mip(int level) const {
+        if (level<=0) return *this;
+        std::lock_guard<std::mutex> lock(mips_mutex_);
+        uint64_t g=generation();
+        const raster* prev=this;
+        for (int l=1; l<=level; l++) {
+            if ((int)mips_.size()<l) {
+                if (prev->width()==1 && prev->height()==1) return *prev;
+                mips_.push_back(std::make_unique<raster>(
+                    std::max(1, prev->width()/2), std::max(1, prev->height()/2)));
+                mips_built_.push_back(UINT64_MAX);
+            }
+            // Pixels changed? Rebuild in place, so references stay valid.
+            raster& m=*mips_[l-1];
+            if (mips_built_[l-1]!=g) {
+                rasterizer::downsample(
+                    { (uint32_t*)m.raw(), m.width(), m.height(), m.width() },
+                    { (uint32_t*)prev->raw(), prev->width(), prev->height(), prev->width() });
+                m.premultiplied_=premultiplied_;
+                m.modified();
+                mips_built_[l-1]=g;
+            }
+            prev=&m;
+        }
+        return *prev;
+    }
+
+    int raster::mip_level(int w, int h) const {
+        int level=0, mw=width(), mh=height();
+        while (mw>=2*w && mh>=2*h && (mw>1 || mh>1)) {
+            mw=std::max(1, mw/2); mh=std::max(1, mh/2);
+            level++;
+        }
+        return level;
+    }
+//{{END.DEF}}
+
+} // namespace nice
@@ -24,11 +24,11 @@ namespace nice {
     class raster {
     public:
         // Constructs a new raster.        
-        raster(int width, int height) {
+        raster(int width, int height) : id_(next_id()) {
             native_=std::make_unique<native_raster>(width, height);
         }
         // Construct a raster from resource.
-        raster(int width, int height, const uint8_t * argb) {
+        raster(int width, int height, const uint8_t * argb) : id_(next_id()) {
             native_=std::make_unique<native_raster>(width, height, argb);
         }
         // Destructs the raster.
@@ -39,9 +39,75 @@ namespace nice {
         int height() const { return native_->height(); }
         // Pointer to raw data.
         uint8_t* raw() const { return native_->raw(); }
+        // Native raster (for the artist).
+        native_raster* native() const { return native_.get(); }
+        // Convert pixels to premultiplied alpha, once after loading. 
+        // Premultiplied rasters are composited over the background,
+        // other rasters are copied (alpha is ignored).
+        void premultiply() {
+            if (premultiplied_) return;
+            rasterizer::premultiply((uint32_t*)raw(), width()*height());
+            premultiplied_=true;
+            modified();
+        }
+        bool premultiplied() const { return premultiplied_; }
+        // Pixels already are premultiplied (i.e. drawn over transparent).
+        void premultiplied(bool pm) { premultiplied_=pm; }
+        // Unique raster id, and generation of its pixels. Call modified()
+        // after writing to raw(), so that uploaded copies are refreshed
+        // (drawing to raster with an artist does it for you).
+        uint64_t id() const { return id_; }
+        uint64_t generation() const { 
+            return generation_.load(std::memory_order_relaxed); 
+        }
+        void modified() { generation_.fetch_add(1, std::memory_order_relaxed); }
+        // Only r changed (i.e. glyph added to atlas), uploaded copies
+        // refresh just that. Not for concurrent writers. Last changes_kept
+        // changes are remembered, older ones refresh all.
+        static constexpr size_t changes_kept=8;
+        void modified(rct r) {
+            uint64_t g=generation_.fetch_add(1, std::memory_order_relaxed)+1;
+            changes_[next_change_++ % changes_.size()]={ g, r };
+        }
+        // Bounds of changes after generation g, all if unknown.
+        rct changed_since(uint64_t g) const {
+            uint64_t now=generation(), known=0;
+            if (g>=now) return { 0, 0, 0, 0 };
+            rct r { 0, 0, 0, 0 };
+            for (auto const& c : changes_) {
+                if (c.first<=g || c.first>now) continue;
+                r=known++ ? region::bounds(r, c.second) : c.second;
+            }
+            if (known!=now-g) return { 0, 0, width(), height() };
+            return r;
+        }
+        // Hint that pixels rarely change. Backends keep an uploaded copy
+        // (i.e. X11 pixmap) and refresh it only when generation changes.
+        void keep_uploaded(bool keep) { keep_uploaded_=keep; }
+        bool keep_uploaded() const { return keep_uploaded_; }
+        // Mipmap level, each half the size of previous (0 is this one). 
+        // Built on first use and after pixels change. Thread safe.
+        const raster& mip(int level) const;
+        // Level to draw from when scaling to w x h (reduces at most 2x).
+        int mip_level(int w, int h) const;
     private:
         // PIMPL.
         std::unique_ptr<native_raster> native_;
+        bool premultiplied_ {false};
+        uint64_t id_;
+        std::atomic<uint64_t> generation_ {0};
+        bool keep_uploaded_ {false};
+        // Last partial changes (generation, area).
+        std::array<std::pair<uint64_t, rct>, changes_kept> changes_ {};
+        size_t next_change_ {0};
+        // Mipmaps from level 1, and generations they were built from.
+        mutable std::vector<std::unique_ptr<raster>> mips_;
+        mutable std::vector<uint64_t> mips_built_;
+        mutable std::mutex mips_mutex_;
+        static uint64_t next_id() {
+            static std::atomic<uint64_t> id {0};
+            return ++id;
+        }
     };
 //{{END.DEC}}
 } // namespace nice
@@ -0,0 +1,783 @@
+//
+// rasterizer.cpp
+// 
+// Software rasterizer implementation.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    // Source over: dst = src + dst * (255 - src alpha) / 255, two
+    // channels at a time. x/255 is (x + 128 + ((x + 128) >> 8)) >> 8.
+    static void blend_span_scalar(uint32_t* dst, const uint32_t* src, int n) {
+        for (int i=0; i<n; i++) {
+            uint32_t s=src[i], a=s>>24;
+            if (a==0xff) { dst[i]=s; continue; }
+            if (a==0) continue;
+            uint32_t ia=0xff-a, d=dst[i];
+            uint32_t rb=(d & 0xff00ff) * ia + 0x800080;
+            rb=((rb + ((rb>>8) & 0xff00ff)) >> 8) & 0xff00ff;
+            uint32_t ag=((d>>8) & 0xff00ff) * ia + 0x800080;
+            ag=(ag + ((ag>>8) & 0xff00ff)) & 0xff00ff00;
+            dst[i]=s + (rb | ag);
+        }
+    }
+
+    // Cells hold signed area in 16.16 fixed point. Integer sums don't 
+    // depend on the order, so coverage is the same however it is clipped.
+    static constexpr int32_t cell_one=1<<16;
+
+    // Coverage from accumulated signed area. Non zero clamps it to 1, 
+    // even odd folds it back every second unit.
+    static inline uint8_t coverage(int32_t acc, bool even_odd) {
+        float a=std::fabs((float)acc*(1.0f/cell_one));
+        if (even_odd) {
+            a-=2*(float)(int)(a*0.5f);
+            a=std::min(a, 2-a);
+        } else a=std::min(a, 1.0f);
+        return (uint8_t)(a*255.0f + 0.5f);
+    }
+
+    static void coverage_span_scalar(int32_t acc, int32_t* cells, uint8_t* cov, int n, bool even_odd) {
+        for (int i=0; i<n; i++) {
+            acc+=cells[i];
+            cells[i]=0;
+            cov[i]=coverage(acc, even_odd);
+        }
+    }
+
+#if defined(__x86_64__) || defined(_M_X64)
+    // SSE2 is always there on x86-64.
+    static void fill_span_sse2(uint32_t* dst, int n, uint32_t px) {
+        __m128i v=_mm_set1_epi32((int)px);
+        int i=0;
+        for (; i+4<=n; i+=4) _mm_storeu_si128((__m128i*)(dst+i), v);
+        for (; i<n; i++) dst[i]=px;
+    }
+
+#ifdef _MSC_VER
+    static void fill_span_avx2(uint32_t* dst, int n, uint32_t px) {
+#else
+    __attribute__((target("avx2"))) 
+    static void fill_span_avx2(uint32_t* dst, int n, uint32_t px) {
+#endif
+        __m256i v=_mm256_set1_epi32((int)px);
+        int i=0;
+        for (; i+8<=n; i+=8) _mm256_storeu_si256((__m256i*)(dst+i), v);
+        for (; i<n; i++) dst[i]=px;
+    }
+
+    // Blend two pixels, unpacked to 16 bit channels.
+    static inline __m128i blend_sse2(__m128i s, __m128i d) {
+        // Inverse source alpha in all four channels of each pixel.
+        __m128i a=_mm_shufflehi_epi16(_mm_shufflelo_epi16(s, 0xff), 0xff);
+        __m128i x=_mm_mullo_epi16(d, _mm_sub_epi16(_mm_set1_epi16(0xff), a));
+        x=_mm_add_epi16(x, _mm_set1_epi16(0x80));
+        x=_mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+        return _mm_add_epi16(s, x);
+    }
+
+    static void blend_span_sse2(uint32_t* dst, const uint32_t* src, int n) {
+        const __m128i zero=_mm_setzero_si128();
+        int i=0;
+        for (; i+4<=n; i+=4) {
+            __m128i s=_mm_loadu_si128((const __m128i*)(src+i));
+            __m128i d=_mm_loadu_si128((const __m128i*)(dst+i));
+            __m128i lo=blend_sse2(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+            __m128i hi=blend_sse2(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+            _mm_storeu_si128((__m128i*)(dst+i), _mm_packus_epi16(lo, hi));
+        }
+        blend_span_scalar(dst+i, src+i, n-i);
+    }
+
+    // Running sum of four cells at a time: two shifted adds give the 
+    // prefix sum within the vector, carry is the last sum broadcast.
+    static void coverage_span_sse2(int32_t* cells, uint8_t* cov, int n, bool even_odd) {
+        const __m128 sign=_mm_set1_ps(-0.0f), one=_mm_set1_ps(1.0f), 
+            two=_mm_set1_ps(2.0f), half=_mm_set1_ps(0.5f), 
+            scale=_mm_set1_ps(255.0f), unit=_mm_set1_ps(1.0f/cell_one);
+        __m128i carry=_mm_setzero_si128();
+        int i=0;
+        for (; i+4<=n; i+=4) {
+            __m128i x=_mm_loadu_si128((const __m128i*)(cells+i));
+            x=_mm_add_epi32(x, _mm_slli_si128(x, 4));
+            x=_mm_add_epi32(x, _mm_slli_si128(x, 8));
+            x=_mm_add_epi32(x, carry);
+            carry=_mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+            _mm_storeu_si128((__m128i*)(cells+i), _mm_setzero_si128());
+            __m128 a=_mm_andnot_ps(sign, _mm_mul_ps(_mm_cvtepi32_ps(x), unit));
+            if (even_odd) {
+                __m128 k=_mm_cvtepi32_ps(_mm_cvttps_epi32(_mm_mul_ps(a, half)));
+                a=_mm_sub_ps(a, _mm_mul_ps(k, two));
+                a=_mm_min_ps(a, _mm_sub_ps(two, a));
+            } else a=_mm_min_ps(a, one);
+            __m128i c=_mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(a, scale), half));
+            c=_mm_packs_epi32(c, c);
+            c=_mm_packus_epi16(c, c);
+            int packed=_mm_cvtsi128_si32(c);
+            std::memcpy(cov+i, &packed, 4);
+        }
+        coverage_span_scalar(_mm_cvtsi128_si32(carry), cells+i, cov+i, n-i, even_odd);
+    }
+
+    // Four channels of a pixel are one vector, no shuffling needed.
+    static void hfilter_sse2(const uint32_t* src, const int* start, 
+        const int* count, const float* weights, float* out, int n) {
+        const __m128i zero=_mm_setzero_si128();
+        for (int i=0; i<n; i++) {
+            __m128 acc=_mm_setzero_ps();
+            const uint32_t* p=src+start[i];
+            for (int k=0; k<count[i]; k++) {
+                __m128i px=_mm_unpacklo_epi16(
+                    _mm_unpacklo_epi8(_mm_cvtsi32_si128((int)p[k]), zero), zero);
+                acc=_mm_add_ps(acc, _mm_mul_ps(_mm_cvtepi32_ps(px), _mm_set1_ps(*weights++)));
+            }
+            _mm_storeu_ps(out+4*i, acc);
+        }
+    }
+
+    static void vfilter_sse2(const float* const* rows, const float* weights, 
+        int taps, uint32_t* out, int n) {
+        const __m128 half=_mm_set1_ps(0.5f);
+        int i=0;
+        // Two pixels per iteration, packed together.
+        for (; i+2<=n; i+=2) {
+            __m128 a=_mm_setzero_ps(), b=_mm_setzero_ps();
+            for (int k=0; k<taps; k++) {
+                __m128 w=_mm_set1_ps(weights[k]);
+                a=_mm_add_ps(a, _mm_mul_ps(w, _mm_loadu_ps(rows[k]+4*i)));
+                b=_mm_add_ps(b, _mm_mul_ps(w, _mm_loadu_ps(rows[k]+4*i+4)));
+            }
+            __m128i v=_mm_packs_epi32(
+                _mm_cvttps_epi32(_mm_add_ps(a, half)), 
+                _mm_cvttps_epi32(_mm_add_ps(b, half)));
+            _mm_storel_epi64((__m128i*)(out+i), _mm_packus_epi16(v, v));
+        }
+        if (i<n) {
+            __m128 a=_mm_setzero_ps();
+            for (int k=0; k<taps; k++)
+                a=_mm_add_ps(a, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(rows[k]+4*i)));
+            __m128i v=_mm_cvttps_epi32(_mm_add_ps(a, half));
+            v=_mm_packs_epi32(v, v);
+            out[i]=(uint32_t)_mm_cvtsi128_si32(_mm_packus_epi16(v, v));
+        }
+    }
+
+#ifdef _MSC_VER
+    static inline __m256i blend_avx2(__m256i s, __m256i d) {
+#else
+    __attribute__((target("avx2"))) 
+    static inline __m256i blend_avx2(__m256i s, __m256i d) {
+#endif
+        __m256i a=_mm256_shufflehi_epi16(_mm256_shufflelo_epi16(s, 0xff), 0xff);
+        __m256i x=_mm256_mullo_epi16(d, _mm256_sub_epi16(_mm256_set1_epi16(0xff), a));
+        x=_mm256_add_epi16(x, _mm256_set1_epi16(0x80));
+        x=_mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+        return _mm256_add_epi16(s, x);
+    }
+
+#ifdef _MSC_VER
+    static void blend_span_avx2(uint32_t* dst, const uint32_t* src, int n) {
+#else
+    __attribute__((target("avx2"))) 
+    static void blend_span_avx2(uint32_t* dst, const uint32_t* src, int n) {
+#endif
+        const __m256i zero=_mm256_setzero_si256();
+        int i=0;
+        for (; i+8<=n; i+=8) {
+            __m256i s=_mm256_loadu_si256((const __m256i*)(src+i));
+            __m256i d=_mm256_loadu_si256((const __m256i*)(dst+i));
+            // Unpack and pack work within 128 bit lanes, so pixels keep order.
+            __m256i lo=blend_avx2(_mm256_unpacklo_epi8(s, zero), _mm256_unpacklo_epi8(d, zero));
+            __m256i hi=blend_avx2(_mm256_unpackhi_epi8(s, zero), _mm256_unpackhi_epi8(d, zero));
+            _mm256_storeu_si256((__m256i*)(dst+i), _mm256_packus_epi16(lo, hi));
+        }
+        blend_span_scalar(dst+i, src+i, n-i);
+    }
+
+    static bool cpu_has_avx2() {
+#ifdef _MSC_VER
+        int r[4];
+        __cpuid(r, 0);
+        if (r[0]<7) return false;
+        __cpuid(r, 1);
+        // OS must save ymm registers (OSXSAVE and AVX, then XCR0).
+        if ((r[2] & (1<<27))==0 || (r[2] & (1<<28))==0) return false;
+        if ((_xgetbv(0) & 6)!=6) return false;
+        __cpuidex(r, 7, 0);
+        return (r[1] & (1<<5))!=0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#else
+    // Portable kernels.
+    static void fill_span_scalar(uint32_t* dst, int n, uint32_t px) {
+        std::fill_n(dst, n, px);
+    }
+
+    static void coverage_span_scalar(int32_t* cells, uint8_t* cov, int n, bool even_odd) {
+        coverage_span_scalar(0, cells, cov, n, even_odd);
+    }
+
+    // Filter kernels. Weights of a pixel start at sum of previous counts.
+    static void hfilter_scalar(const uint32_t* src, const int* start, 
+        const int* count, const float* weights, float* out, int n) {
+        for (int i=0; i<n; i++) {
+            float acc[4] { 0, 0, 0, 0 };
+            for (int k=0; k<count[i]; k++) {
+                uint32_t p=src[start[i]+k];
+                float w=*weights++;
+                for (int c=0; c<4; c++) acc[c]+=w * ((p>>(8*c)) & 0xff);
+            }
+            for (int c=0; c<4; c++) out[4*i+c]=acc[c];
+        }
+    }
+
+    static void vfilter_scalar(const float* const* rows, const float* weights, 
+        int taps, uint32_t* out, int n) {
+        for (int i=0; i<n; i++) {
+            uint32_t p=0;
+            for (int c=0; c<4; c++) {
+                float acc=0;
+                for (int k=0; k<taps; k++) acc+=weights[k] * rows[k][4*i+c];
+                int v=(int)(acc+0.5f);
+                p|=(uint32_t)std::clamp(v, 0, 255)<<(8*c);
+            }
+            out[i]=p;
+        }
+    }
+#endif
+
+    rasterizer::fill_span_fn rasterizer::fill_span_ = rasterizer::select_fill_span();
+    rasterizer::blend_span_fn rasterizer::blend_span_ = rasterizer::select_blend_span();
+
+    rasterizer::fill_span_fn rasterizer::select_fill_span() {
+#if defined(__x86_64__) || defined(_M_X64)
+        if (cpu_has_avx2()) return fill_span_avx2;
+        return fill_span_sse2;
+#else
+        return fill_span_scalar;
+#endif
+    }
+
+    rasterizer::blend_span_fn rasterizer::select_blend_span() {
+#if defined(__x86_64__) || defined(_M_X64)
+        if (cpu_has_avx2()) return blend_span_avx2;
+        return blend_span_sse2;
+#else
+        return blend_span_scalar;
+#endif
+    }
+
+    rasterizer::coverage_span_fn rasterizer::coverage_span_ = rasterizer::select_coverage_span();
+
+    rasterizer::coverage_span_fn rasterizer::select_coverage_span() {
+#if defined(__x86_64__) || defined(_M_X64)
+        return coverage_span_sse2;
+#else
+        return coverage_span_scalar;
+#endif
+    }
+
+#if defined(__x86_64__) || defined(_M_X64)
+    rasterizer::hfilter_fn rasterizer::hfilter_ = hfilter_sse2;
+    rasterizer::vfilter_fn rasterizer::vfilter_ = vfilter_sse2;
+#else
+    rasterizer::hfilter_fn rasterizer::hfilter_ = hfilter_scalar;
+    rasterizer::vfilter_fn rasterizer::vfilter_ = vfilter_scalar;
+#endif
+
+    const char* rasterizer::kernels() {
+#if defined(__x86_64__) || defined(_M_X64)
+        if (fill_span_==fill_span_avx2) return "avx2";
+        if (fill_span_==fill_span_sse2) return "sse2";
+#endif
+        return "scalar";
+    }
+
+    void rasterizer::fill_rect(const surface& s, uint32_t px, rct r, const region& clip) {
+        for_each_clip(s, clip, [&](rct cr) {
+            rct f=region::intersection(r, cr);
+            if (region::empty(f)) return;
+            for (int y=f.y; y<f.y+f.h; y++)
+                fill_span_(s.bits+y*s.stride+f.x, f.w, px);
+        });
+    }
+
+    void rasterizer::draw_rect(const surface& s, uint32_t px, rct r, const region& clip) {
+        if (region::empty(r)) return;
+        // Four spans.
+        fill_rect(s, px, { r.x, r.y, r.w, 1 }, clip);
+        if (r.h==1) return;
+        fill_rect(s, px, { r.x, r.y+r.h-1, r.w, 1 }, clip);
+        fill_rect(s, px, { r.x, r.y+1, 1, r.h-2 }, clip);
+        if (r.w>1) fill_rect(s, px, { r.x+r.w-1, r.y+1, 1, r.h-2 }, clip);
+    }
+
+    // Floor of a/b, b>0.
+    static inline int64_t floor_div(int64_t a, int64_t b) {
+        return a>=0 ? a/b : -((-a+b-1)/b);
+    }
+
+    // Narrow steps [lo,hi] of a line to those where the coordinate 
+    // start + dir * floor((2*i*m + n) / 2n) is within [cmin,cmax]. 
+    // With m=n=1 the coordinate moves by one per step.
+    static void clip_steps(int64_t& lo, int64_t& hi, int start, int dir, 
+        int cmin, int cmax, int64_t m, int64_t n) {
+        // Offsets from start, in the direction of the line.
+        int64_t omin=dir>0 ? cmin-start : start-cmax, omax=dir>0 ? cmax-start : start-cmin;
+        if (omax<0 || m==0) {
+            if (omin>0 || omax<0) hi=lo-1;
+            return;
+        }
+        // Offset >= k from i >= ceil((2k-1)n / 2m), <= k up to 
+        // ceil((2k+1)n / 2m) - 1.
+        if (omin>0) lo=std::max(lo, -floor_div(-(2*omin-1)*n, 2*m));
+        hi=std::min(hi, -floor_div(-(2*omax+1)*n, 2*m)-1);
+    }
+
+    void rasterizer::draw_line(const surface& s, uint32_t px, pt p1, pt p2, const region& clip) {
+        // Horizontal and vertical lines are spans.
+        if (p1.y==p2.y) {
+            coord x=std::min(p1.x, p2.x);
+            fill_rect(s, px, { x, p1.y, std::max(p1.x, p2.x)-x+1, 1 }, clip);
+            return;
+        }
+        if (p1.x==p2.x) {
+            coord y=std::min(p1.y, p2.y);
+            fill_rect(s, px, { p1.x, y, 1, std::max(p1.y, p2.y)-y+1 }, clip);
+            return;
+        }
+        // Step i moves the major axis by one and the minor axis by
+        // round(i*minor/major), so the part of the line inside a clip 
+        // rectangle can be found, and walked, without the rest.
+        int dx=p2.x-p1.x, dy=p2.y-p1.y;
+        bool xmajor=std::abs(dx)>=std::abs(dy);
+        int64_t n=xmajor ? std::abs(dx) : std::abs(dy), m=xmajor ? std::abs(dy) : std::abs(dx);
+        int sx=dx>0 ? 1 : -1, sy=dy>0 ? 1 : -1;
+        for_each_clip(s, clip, [&](rct cr) {
+            // Steps where the major axis is inside.
+            int64_t lo=0, hi=n;
+            clip_steps(lo, hi, xmajor ? p1.x : p1.y, xmajor ? sx : sy, 
+                xmajor ? cr.x : cr.y, xmajor ? cr.x+cr.w-1 : cr.y+cr.h-1, 1, 1);
+            // And the minor one.
+            clip_steps(lo, hi, xmajor ? p1.y : p1.x, xmajor ? sy : sx, 
+                xmajor ? cr.y : cr.x, xmajor ? cr.y+cr.h-1 : cr.x+cr.w-1, m, n);
+            if (lo>hi) return;
+            // Minor offset is floor((2*i*m + n) / 2n), walk it from lo.
+            int64_t num=2*lo*m+n, off=num/(2*n), rem=num%(2*n);
+            for (int64_t i=lo; i<=hi; i++) {
+                int x=p1.x+sx*(int)(xmajor ? i : off), y=p1.y+sy*(int)(xmajor ? off : i);
+                s.bits[y*s.stride+x]=px;
+                rem+=2*m;
+                if (rem>=2*n) { rem-=2*n; off++; }
+            }
+        });
+    }
+
+    void rasterizer::blit(const surface& s, const surface& src, pt p, const region& clip) {
+        for_each_clip(s, clip, [&](rct cr) {
+            rct f=region::intersection({ p.x, p.y, src.width, src.height }, cr);
+            if (region::empty(f)) return;
+            for (int y=f.y; y<f.y+f.h; y++)
+                std::memcpy(
+                    s.bits+y*s.stride+f.x, 
+                    src.bits+(y-p.y)*src.stride+(f.x-p.x), 
+                    f.w*sizeof(uint32_t));
+        });
+    }
+
+    void rasterizer::blend(const surface& s, const surface& src, pt p, const region& clip) {
+        for_each_clip(s, clip, [&](rct cr) {
+            rct f=region::intersection({ p.x, p.y, src.width, src.height }, cr);
+            if (region::empty(f)) return;
+            for (int y=f.y; y<f.y+f.h; y++)
+                blend_span_(
+                    s.bits+y*s.stride+f.x, 
+                    src.bits+(y-p.y)*src.stride+(f.x-p.x), 
+                    f.w);
+        });
+    }
+
+    void rasterizer::add_edge(std::vector<cell>& cells, int32_t* cover, int w, 
+        int top, int h, int left, int cw, ptf a, ptf b) {
+        if (a.y==b.y) return;
+        // Pieces left of 0 are moved to it (they still cover pixels 
+        // right of them), pieces right of w don't change any pixel.
+        float ts[4] { 0, 0, 0, 1 };
+        int nt=1;
+        float dx=b.x-a.x;
+        if (dx!=0) {
+            for (float edge : { 0.0f, (float)w }) {
+                float t=(edge-a.x)/dx;
+                if (t>0 && t<1) ts[nt++]=t;
+            }
+        }
+        if (nt==3 && ts[1]>ts[2]) std::swap(ts[1], ts[2]);
+        ts[nt++]=1;
+        for (int k=0; k+1<nt; k++) {
+            float t0=ts[k], t1=ts[k+1];
+            ptf p { a.x+dx*t0, a.y+(b.y-a.y)*t0 }, q { a.x+dx*t1, a.y+(b.y-a.y)*t1 };
+            if ((p.x+q.x)*0.5f>=w) continue;
+            p.x=std::clamp(p.x, 0.0f, (float)w);
+            q.x=std::clamp(q.x, 0.0f, (float)w);
+            float dir=1;
+            if (p.y>q.y) { std::swap(p, q); dir=-1; }
+            if (p.y==q.y) continue;
+            float dxdy=(q.x-p.x)/(q.y-p.y);
+            int y0=std::max(top, (int)std::floor(p.y)), y1=std::min(top+h, (int)std::ceil(q.y));
+            for (int y=y0; y<y1; y++) {
+                float ya=std::max((float)y, p.y), yb=std::min((float)(y+1), q.y);
+                float xa=std::clamp(p.x + (ya-p.y)*dxdy, 0.0f, (float)w);
+                float xb=std::clamp(p.x + (yb-p.y)*dxdy, 0.0f, (float)w);
+                float d=(yb-ya)*dir;
+                float xl=std::min(xa, xb), xr=std::max(xa, xb);
+                int il=(int)xl, ir=(int)std::ceil(xr);
+                if (il-left>=cw) continue;
+                int row=y-top;
+                auto add=[&](int x, int32_t c) {
+                    if (x-left<cw) cells.push_back({ row, std::max(0, x-left), c });
+                };
+                if (std::max(ir, il+1)<=left) {
+                    // All of it left of cells.
+                    cover[row]+=(int32_t)(d*cell_one);
+                    continue;
+                }
+                // Parts are rounded, the last one gets what is left.
+                int32_t sum=0;
+                auto put=[&](int x, float v) {
+                    int32_t c=(int32_t)(v*cell_one);
+                    sum+=c;
+                    add(x, c);
+                };
+                if (ir<=il+1) {
+                    // Within one pixel, trapezoid split at its middle.
+                    float xm=0.5f*(xa+xb)-il;
+                    put(il, d*(1-xm));
+                    ir=il+1;
+                } else {
+                    // Triangles at both ends, equal parts in between.
+                    float s=1/(xr-xl), fl=xl-il, fr=xr-ir+1;
+                    float a0=0.5f*s*(1-fl)*(1-fl), am=0.5f*s*fr*fr;
+                    put(il, d*a0);
+                    if (ir==il+2) 
+                        put(il+1, d*(1-a0-am));
+                    else {
+                        float a1=s*(1.5f-fl);
+                        put(il+1, d*(a1-a0));
+                        // Equal parts, the ones left of cells at once.
+                        int32_t c=(int32_t)(d*s*cell_one);
+                        int x=il+2, xe=ir-2, xf=std::min(xe+1, left);
+                        if (xf>x) { add(left, c*(xf-x)); sum+=c*(xf-x); x=xf; }
+                        for (; x<=xe; x++) {
+                            sum+=c;
+                            add(x, c);
+                        }
+                        float a2=a1+(ir-il-3)*s;
+                        put(ir-1, d*(1-a2-am));
+                    }
+                }
+                add(ir, (int32_t)(d*cell_one)-sum);
+            }
+        }
+    }
+
+    rct rasterizer::polygon_bounds(const std::vector<polygon>& polys) {
+        bool any=false;
+        float x0=0, y0=0, x1=0, y1=0;
+        for (auto const& poly : polys) 
+            for (auto const& p : poly) {
+                if (!any) { x0=x1=p.x; y0=y1=p.y; any=true; }
+                x0=std::min(x0, p.x); y0=std::min(y0, p.y);
+                x1=std::max(x1, p.x); y1=std::max(y1, p.y);
+            }
+        if (!any) return { 0, 0, 0, 0 };
+        rct b { (coord)std::floor(x0), (coord)std::floor(y0), 0, 0 };
+        b.w=(coord)std::ceil(x1)-b.x+1; 
+        b.h=(coord)std::ceil(y1)-b.y+1;
+        return b;
+    }
+
+    void rasterizer::fill_polygons(const surface& s, uint32_t px, 
+        const std::vector<polygon>& polys, fill_rule rule, const region& clip,
+        rct bounds) {
+        // Area to rasterize: polygons within surface and clip.
+        rct pb=region::empty(bounds) ? polygon_bounds(polys) : bounds;
+        if (region::empty(pb)) return;
+        thread_local std::vector<rct> rects;
+        rects.clear();
+        rct cb { 0, 0, 0, 0 };
+        for_each_clip(s, clip, [&](rct cr) { 
+            rects.push_back(cr);
+            cb=region::empty(cb) ? cr : region::bounds(cb, cr);
+        });
+        // Edges are moved to the origin of polygons within surface, not
+        // to the clipped area, so that coverage doesn't depend on clip
+        // (i.e. tiles). Only cells of the area are kept.
+        rct ob=region::intersection(pb, { 0, 0, s.width, s.height });
+        rct area=region::intersection(ob, cb);
+        if (region::empty(area)) return;
+
+        int top=area.y-ob.y, left=area.x-ob.x, w=area.w, h=area.h;
+        thread_local std::vector<cell> cells, sorted;
+        thread_local std::vector<int> first, at;
+        // One scanline. It stays zeroed between calls, coverage span 
+        // clears it.
+        thread_local std::vector<int32_t> line;
+        thread_local std::vector<uint8_t> cov;
+        // Area left of the columns, per row.
+        thread_local std::vector<int32_t> cover;
+        if (line.size()<(size_t)w) line.resize(w);
+        if (cov.size()<(size_t)w) cov.resize(w);
+        cover.assign(h, 0);
+        cells.clear();
+
+        for (auto const& poly : polys) {
+            size_t n=poly.size();
+            if (n<3) continue;
+            for (size_t i=0; i<n; i++) {
+                ptf a { poly[i].x-ob.x, poly[i].y-ob.y }, 
+                    b { poly[(i+1)%n].x-ob.x, poly[(i+1)%n].y-ob.y };
+                // Edges above, below or right of the area don't change it.
+                if (std::max(a.y, b.y)<=top || std::min(a.y, b.y)>=top+h 
+                    || std::min(a.x, b.x)>=left+w) continue;
+                add_edge(cells, cover.data(), ob.w, top, h, left, w, a, b);
+            }
+        }
+
+        // Cells by scanline.
+        first.assign(h+1, 0);
+        for (auto const& c : cells) first[c.row+1]++;
+        for (int r=0; r<h; r++) first[r+1]+=first[r];
+        at.assign(first.begin(), first.end()-1);
+        sorted.resize(cells.size());
+        for (auto const& c : cells) sorted[at[c.row]++]=c;
+
+        // Coverage per scanline, blended where clip allows.
+        bool even_odd=rule==fill_rule::even_odd;
+        for (int r=0; r<h; r++) {
+            if (first[r]==first[r+1] && cover[r]==0) continue;
+            int lo=w, hi=-1;
+            if (cover[r]!=0) {
+                line[0]+=cover[r];
+                lo=hi=0;
+            }
+            for (int k=first[r]; k<first[r+1]; k++) {
+                const cell& c=sorted[k];
+                line[c.x]+=c.area;
+                lo=std::min(lo, c.x);
+                hi=std::max(hi, c.x);
+            }
+            coverage_span_(line.data()+lo, cov.data()+lo, hi-lo+1, even_odd);
+            // After the last cell coverage doesn't change. It is not zero
+            // when edges right of the area were skipped.
+            int end=hi;
+            if (end<w-1 && cov[end]!=0) {
+                std::memset(cov.data()+end+1, cov[end], w-1-end);
+                end=w-1;
+            }
+            int y=area.y+r;
+            for (auto const& cr : rects) {
+                if (y<cr.y || y>=cr.y+cr.h) continue;
+                int xs=std::max(lo, cr.x-area.x), 
+                    xe=std::min({ end, w-1, cr.x+cr.w-area.x-1 });
+                if (xs<=xe) 
+                    fill_coverage(s.bits+y*s.stride+area.x+xs, cov.data()+xs, 1, xe-xs+1, px);
+            }
+        }
+
+        // Don't keep memory of a huge path.
+        const size_t most_kept=1<<18;
+        if (cells.capacity()>most_kept) {
+            std::vector<cell>().swap(cells);
+            std::vector<cell>().swap(sorted);
+        }
+    }
+
+    void rasterizer::fill_mask(const surface& s, uint32_t px, 
+        const surface& mask, rct src, pt p, const region& clip) {
+        for_each_clip(s, clip, [&](rct cr) {
+            rct f=region::intersection({ p.x, p.y, src.w, src.h }, cr);
+            if (region::empty(f)) return;
+            for (int y=f.y; y<f.y+f.h; y++) {
+                const uint32_t* m=mask.bits+(src.y+y-p.y)*mask.stride+src.x+f.x-p.x;
+                // Alpha is the high byte (little endian).
+                fill_coverage(s.bits+y*s.stride+f.x, (const uint8_t*)m+3, 4, f.w, px);
+            }
+        });
+    }
+
+    void rasterizer::fill_coverage(uint32_t* dst, const uint8_t* cov, int step, int n, uint32_t px) {
+        for (int x=0; x<n; ) {
+            uint8_t c=cov[x*step];
+            if (c==0xff) {
+                int e=x;
+                while (e<n && cov[e*step]==0xff) e++;
+                fill_span_(dst+x, e-x, px);
+                x=e;
+                continue;
+            }
+            if (c!=0) {
+                // dst = (px * c + dst * (255 - c)) / 255
+                uint32_t d=dst[x], ic=0xff-c;
+                uint32_t rb=(px & 0xff00ff)*c + (d & 0xff00ff)*ic + 0x800080;
+                rb=((rb + ((rb>>8) & 0xff00ff)) >> 8) & 0xff00ff;
+                uint32_t ag=((px>>8) & 0xff00ff)*c + ((d>>8) & 0xff00ff)*ic + 0x800080;
+                ag=(ag + ((ag>>8) & 0xff00ff)) & 0xff00ff00;
+                dst[x]=rb | ag;
+            }
+            x++;
+        }
+    }
+
+    // Source pixels (start, count, weights) contributing to each of 
+    // n destination pixels, when n pixels cover ns source pixels.
+    typedef struct taps_s {
+        std::vector<int> start, count;
+        std::vector<float> weights;
+        int most {0};
+    } taps;
+
+    static void filter_taps(taps& t, int ns, int n, filter f) {
+        t.start.clear(); t.count.clear(); t.weights.clear();
+        t.most=0;
+        double scale=(double)ns/n;
+        auto add=[&](int i, int c, const float* w) {
+            t.start.push_back(i); t.count.push_back(c);
+            t.weights.insert(t.weights.end(), w, w+c);
+            t.most=std::max(t.most, c);
+        };
+        const float one=1;
+        thread_local std::vector<float> w;
+        for (int i=0; i<n; i++) {
+            if (f==filter::nearest) 
+                add(std::min(ns-1, (int)((i+0.5)*scale)), 1, &one);
+            else if (f==filter::bilinear) {
+                double c=(i+0.5)*scale-0.5;
+                int x0=(int)std::floor(c);
+                float fr=(float)(c-x0);
+                // Edges are clamped.
+                if (x0<0) add(0, 1, &one);
+                else if (x0>=ns-1) add(ns-1, 1, &one);
+                else {
+                    w={ 1-fr, fr };
+                    add(x0, 2, w.data());
+                }
+            } else {
+                // Part of footprint [a,b) over each source pixel.
+                double a=i*scale, b=(i+1)*scale;
+                int x0=std::min(ns-1, (int)a), x1=std::max(x0+1, std::min(ns, (int)std::ceil(b)));
+                w.clear();
+                for (int x=x0; x<x1; x++)
+                    w.push_back((float)((std::min(b, x+1.0) - std::max(a, (double)x)) / scale));
+                add(x0, x1-x0, w.data());
+            }
+        }
+    }
+
+    void rasterizer::scale(const surface& s, const surface& src, rct dst, 
+        filter f, bool blend, const region& clip) {
+        if (region::empty(dst) || src.width<=0 || src.height<=0) return;
+        // Scratch, reused by the calls of a thread.
+        thread_local taps tx, ty;
+        thread_local std::vector<int> wy, hrow;
+        thread_local std::vector<float> hrows;
+        thread_local std::vector<const float*> rows;
+        thread_local std::vector<uint32_t> out;
+        filter_taps(tx, src.width, dst.w, f);
+        filter_taps(ty, src.height, dst.h, f);
+        // Weights of each dst pixel, where they start.
+        wy.assign(dst.h+1, 0);
+        for (int i=0; i<dst.h; i++) wy[i+1]=wy[i]+ty.count[i];
+        if (out.size()<(size_t)dst.w) out.resize(dst.w);
+        for_each_clip(s, clip, [&](rct cr) {
+            rct r=region::intersection(dst, cr);
+            if (region::empty(r)) return;
+            int x0=r.x-dst.x, n=r.w;
+            // Horizontal pass of source rows, in a ring (rows only go down).
+            int ring=ty.most;
+            if (hrows.size()<(size_t)(ring*4*n)) hrows.resize(ring*4*n);
+            if (rows.size()<(size_t)ring) rows.resize(ring);
+            hrow.assign(ring, -1);
+            int wx=0;
+            for (int i=0; i<x0; i++) wx+=tx.count[i];
+            for (int y=r.y; y<r.y+r.h; y++) {
+                int i=y-dst.y;
+                uint32_t* d=s.bits+y*s.stride+r.x;
+                if (f==filter::nearest) {
+                    // Just pick pixels.
+                    const uint32_t* row=src.bits+ty.start[i]*src.stride;
+                    for (int x=0; x<n; x++) out[x]=row[tx.start[x0+x]];
+                } else {
+                    for (int k=0; k<ty.count[i]; k++) {
+                        int sy=ty.start[i]+k, slot=sy % ring;
+                        float* h=hrows.data()+slot*4*n;
+                        if (hrow[slot]!=sy) {
+                            hfilter_(src.bits+sy*src.stride, tx.start.data()+x0, 
+                                tx.count.data()+x0, tx.weights.data()+wx, h, n);
+                            hrow[slot]=sy;
+                        }
+                        rows[k]=h;
+                    }
+                    vfilter_(rows.data(), ty.weights.data()+wy[i], ty.count[i], out.data(), n);
+                }
+                if (blend) blend_span_(d, out.data(), n);
+                else std::memcpy(d, out.data(), n*sizeof(uint32_t));
+            }
+        });
+    }
+
+    void rasterizer::downsample(const surface& dst, const surface& src) {
+        for (int y=0; y<dst.height; y++) {
+            // Odd last row or column is repeated.
+            const uint32_t* r0=src.bits+std::min(2*y, src.height-1)*src.stride;
+            const uint32_t* r1=src.bits+std::min(2*y+1, src.height-1)*src.stride;
+            uint32_t* d=dst.bits+y*dst.stride;
+            int x=0;
+#if defined(__x86_64__) || defined(_M_X64)
+            // Two pixels from four columns.
+            const __m128i zero=_mm_setzero_si128(), two=_mm_set1_epi16(2);
+            for (; 2*x+4<=src.width && x+2<=dst.width; x+=2) {
+                __m128i a=_mm_loadu_si128((const __m128i*)(r0+2*x));
+                __m128i b=_mm_loadu_si128((const __m128i*)(r1+2*x));
+                __m128i lo=_mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+                __m128i hi=_mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+                __m128i s=_mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+                s=_mm_srli_epi16(_mm_add_epi16(s, two), 2);
+                _mm_storel_epi64((__m128i*)(d+x), _mm_packus_epi16(s, s));
+            }
+#endif
+            for (; x<dst.width; x++) {
+                int a=std::min(2*x, src.width-1), b=std::min(2*x+1, src.width-1);
+                uint32_t p0=r0[a], p1=r0[b], p2=r1[a], p3=r1[b];
+                // Two channels at a time, sums of four fit in 10 bits.
+                uint32_t rb=(p0 & 0xff00ff) + (p1 & 0xff00ff) + (p2 & 0xff00ff) 
+                    + (p3 & 0xff00ff) + 0x20002;
+                uint32_t ag=((p0>>8) & 0xff00ff) + ((p1>>8) & 0xff00ff) 
+                    + ((p2>>8) & 0xff00ff) + ((p3>>8) & 0xff00ff) + 0x20002;
+                d[x]=((rb>>2) & 0xff00ff) | (((ag>>2) & 0xff00ff)<<8);
+            }
+        }
+    }
+
+    void rasterizer::premultiply(uint32_t* px, int n) {
+        for (int i=0; i<n; i++) {
+            uint32_t p=px[i], a=p>>24;
+            if (a==0xff) continue;
+            uint32_t rb=(p & 0xff00ff) * a + 0x800080;
+            rb=((rb + ((rb>>8) & 0xff00ff)) >> 8) & 0xff00ff;
+            uint32_t g=((p>>8) & 0xff) * a + 0x80;
+            g=((g + (g>>8)) >> 8) & 0xff;
+            px[i]=(a<<24) | (g<<8) | rb;
+        }
+    }
+//{{END.DEF}}
+
+} // namespace nice
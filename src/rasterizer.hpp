@@ -0,0 +1,124 @@
+//
+// rasterizer.hpp
+// 
+// Software drawing to 32 bit BGRA pixels. Used by the artist when
+// it draws to a raster, and by backends without native drawing.
+// Inner loops run on spans, with SSE2 or AVX2 kernels selected at
+// runtime when the CPU has them.
+//
+// Polygons are antialiased without supersampling. Each edge adds 
+// the signed area it covers to cells of the pixels it crosses, running 
+// sum of a scanline then is the exact pixel coverage. Cells are kept
+// per edge crossing, not per pixel of the polygon.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _RASTERIZER_HPP
+#define _RASTERIZER_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    // Pixels to draw to. Stride is in pixels.
+    typedef struct surface_s {
+        uint32_t* bits;
+        int width;
+        int height;
+        int stride;
+    } surface;
+
+    // Resampling filter for scaled rasters.
+    enum class filter : uint8_t { nearest, bilinear, box };
+
+    class rasterizer {
+    public:
+        // Opaque BGRA pixel of color.
+        static uint32_t pixel(color c) {
+            return 0xff000000 | (c.r << 16) | (c.g << 8) | c.b;
+        }
+        // Drawing, clipped to clip region (empty=all) and surface.
+        static void fill_rect(const surface& s, uint32_t px, rct r, const region& clip);
+        static void draw_rect(const surface& s, uint32_t px, rct r, const region& clip);
+        static void draw_line(const surface& s, uint32_t px, pt p1, pt p2, const region& clip);
+        // Copy src to s at p.
+        static void blit(const surface& s, const surface& src, pt p, const region& clip);
+        // Composite premultiplied src over s at p.
+        static void blend(const surface& s, const surface& src, pt p, const region& clip);
+        // Antialiased polygons, filled by rule. Pass their bounds when 
+        // known (i.e. drawn per tile), empty bounds are computed.
+        static void fill_polygons(const surface& s, uint32_t px, 
+            const std::vector<polygon>& polys, fill_rule rule, const region& clip,
+            rct bounds={ 0, 0, 0, 0 });
+        // Pixels polygons can cover (antialiasing reaches into the pixel
+        // after them), empty if there are no points.
+        static rct polygon_bounds(const std::vector<polygon>& polys);
+        // Fill with px through alpha of src pixels in mask (i.e. glyph
+        // in atlas), to p.
+        static void fill_mask(const surface& s, uint32_t px, 
+            const surface& mask, rct src, pt p, const region& clip);
+        // Scale src to dst rectangle. Separable passes: rows are
+        // filtered horizontally once, then combined vertically. 
+        // Composite over if src is premultiplied (blend), else copy.
+        static void scale(const surface& s, const surface& src, rct dst, 
+            filter f, bool blend, const region& clip);
+        // Half size of src (2x2 box) to dst.
+        static void downsample(const surface& dst, const surface& src);
+        // Convert straight alpha pixels to premultiplied alpha.
+        static void premultiply(uint32_t* px, int n);
+        // Name of selected kernels (scalar, sse2 or avx2).
+        static const char* kernels();
+    private:
+        // Call f for every clip rectangle, clipped to surface.
+        template<typename F> 
+        static void for_each_clip(const surface& s, const region& clip, F f) {
+            rct all { 0, 0, s.width, s.height };
+            if (clip.empty()) 
+                f(all);
+            else for (auto const& r : clip.rects()) {
+                rct cr=region::intersection(r, all);
+                if (!region::empty(cr)) f(cr);
+            }
+        }
+        // Span kernels, selected at startup.
+        typedef void (*fill_span_fn)(uint32_t* dst, int n, uint32_t px);
+        typedef void (*blend_span_fn)(uint32_t* dst, const uint32_t* src, int n);
+        // Running sum of n (fixed point) cells to 8 bit coverage, clears cells.
+        typedef void (*coverage_span_fn)(int32_t* cells, uint8_t* cov, int n, bool even_odd);
+        static fill_span_fn fill_span_;
+        static blend_span_fn blend_span_;
+        static fill_span_fn select_fill_span();
+        static blend_span_fn select_blend_span();
+        // Blend px to n pixels, by coverage at every step-th byte.
+        static void fill_coverage(uint32_t* dst, const uint8_t* cov, int step, int n, uint32_t px);
+        static coverage_span_fn coverage_span_;
+        static coverage_span_fn select_coverage_span();
+        // Weighted sums of n pixels to four floats each (horizontal
+        // pass), and of rows of such floats back to pixels (vertical).
+        typedef void (*hfilter_fn)(const uint32_t* src, const int* start, 
+            const int* count, const float* weights, float* out, int n);
+        typedef void (*vfilter_fn)(const float* const* rows, const float* weights, 
+            int taps, uint32_t* out, int n);
+        static hfilter_fn hfilter_;
+        static vfilter_fn vfilter_;
+        // Signed area (fixed point) of a pixel, row and column are 
+        // relative to the rasterized area.
+        typedef struct cell_s {
+            int32_t row;
+            int32_t x;
+            int32_t area;
+        } cell;
+        // Add cells of edge (a,b) within 0..w for rows top..top+h-1. Cells 
+        // cover columns left..left+cw-1, area left of them goes to the 
+        // first one. Rows of the edge that are all left of the cells add
+        // to cover (per row) instead, i.e. edges left of a tile.
+        static void add_edge(std::vector<cell>& cells, int32_t* cover, int w, 
+            int top, int h, int left, int cw, ptf a, ptf b);
+    };
+//{{END.DEC}}
+
+} // namespace nice
+
+#endif // _RASTERIZER_HPP
@@ -0,0 +1,95 @@
+//
+// region.cpp
+// 
+// Region implementation. 
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+//{{BEGIN.DEF}}
+    rct region::intersection(rct a, rct b) {
+        coord x1=std::max(a.x, b.x), y1=std::max(a.y, b.y);
+        coord x2=std::min(a.x+a.w, b.x+b.w), y2=std::min(a.y+a.h, b.y+b.h);
+        if (x2<=x1 || y2<=y1) return { 0, 0, 0, 0 };
+        return { x1, y1, x2-x1, y2-y1 };
+    }
+
+    rct region::bounds(rct a, rct b) {
+        if (empty(a)) return b;
+        if (empty(b)) return a;
+        coord x1=std::min(a.x, b.x), y1=std::min(a.y, b.y);
+        coord x2=std::max(a.x+a.w, b.x+b.w), y2=std::max(a.y+a.h, b.y+b.h);
+        return { x1, y1, x2-x1, y2-y1 };
+    }
+
+    rct region::bounds() const {
+        rct b { 0, 0, 0, 0 };
+        for (auto const& r : rects_) b=bounds(b, r);
+        return b;
+    }
+
+    bool region::intersects(rct r) const {
+        for (auto const& e : rects_) 
+            if (!empty(intersection(e, r))) return true;
+        return false;
+    }
+
+    void region::add(const region& other) {
+        for (auto const& r : other.rects_) add(r);
+    }
+
+    void region::add(rct r) {
+        if (empty(r)) return;
+        auto area=[](rct a) { return (long long)a.w * a.h; };
+        std::vector<rct> pending { r };
+        int budget=4*max_rects; // Don't loop forever on nasty input.
+        while (!pending.empty() && budget-- > 0) {
+            rct p=pending.back(); pending.pop_back();
+            bool done=false;
+            for (size_t i=0; i<rects_.size() && !done; i++) {
+                rct e=rects_[i];
+                rct x=intersection(e, p);
+                // Already covered?
+                if (area(x)==area(p)) { done=true; break; }
+                // Swallows existing?
+                if (area(x)==area(e)) { 
+                    rects_.erase(rects_.begin()+i); i--; 
+                    continue; 
+                }
+                // Merge if bounding rectangle wastes little area.
+                rct b=bounds(e, p);
+                long long u=area(e)+area(p)-area(x);
+                bool touching=!empty(intersection(
+                    { e.x-1, e.y-1, e.w+2, e.h+2 }, p));
+                if (touching && area(b)-u <= u/4) {
+                    rects_.erase(rects_.begin()+i);
+                    pending.push_back(b);
+                    done=true;
+                } else if (!empty(x)) {
+                    // Split p around e into (up to) four bands.
+                    if (p.y<x.y) pending.push_back({ p.x, p.y, p.w, x.y-p.y });
+                    if (p.y+p.h>x.y+x.h) 
+                        pending.push_back({ p.x, x.y+x.h, p.w, p.y+p.h-x.y-x.h });
+                    if (p.x<x.x) pending.push_back({ p.x, x.y, x.x-p.x, x.h });
+                    if (p.x+p.w>x.x+x.w) 
+                        pending.push_back({ x.x+x.w, x.y, p.x+p.w-x.x-x.w, x.h });
+                    done=true;
+                }
+            }
+            if (!done) rects_.push_back(p);
+        }
+        // Too many rectangles (or budget exceeded)? Just use bounds.
+        if (!pending.empty() || (int)rects_.size() > max_rects) {
+            rct b=bounds();
+            for (auto const& p : pending) b=bounds(b, p);
+            rects_.clear();
+            rects_.push_back(b);
+        }
+    }
+//{{END.DEF}}
+}
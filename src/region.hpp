@@ -0,0 +1,51 @@
+//
+// region.hpp
+// 
+// A small set of non overlapping rectangles. Used to collect 
+// damaged (dirty) areas of a window between paints. 
+//
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _REGION_HPP
+#define _REGION_HPP
+
+#include "includes.hpp"
+#include "geometry.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    class region {
+    public:
+        // Add rectangle. Merges it with neighbours when that 
+        // doesn't add much area, otherwise keeps rectangles disjoint.
+        void add(rct r);
+        // Add all rectangles of other region.
+        void add(const region& other);
+        // Remove all rectangles.
+        void clear() { rects_.clear(); }
+        // No rectangles?
+        bool empty() const { return rects_.empty(); }
+        // Rectangles.
+        const std::vector<rct>& rects() const { return rects_; }
+        // Bounding rectangle.
+        rct bounds() const;
+        // Does rectangle intersect region?
+        bool intersects(rct r) const;
+        // Helpers.
+        static bool empty(rct r) { return r.w<=0 || r.h<=0; }
+        static rct intersection(rct a, rct b);
+        static rct bounds(rct a, rct b);
+    private:
+        // Above this we give up and use the bounding rectangle.
+        static constexpr int max_rects = 16;
+        std::vector<rct> rects_;
+    };
+//{{END.DEC}}
+
+}
+
+#endif // _REGION_HPP
@@ -31,34 +31,142 @@ namespace nice {
                 });
         }
 
-        int connect(std::function<bool(Args...)> const& slot) const {
+        template <typename F> 
+        requires std::is_invocable_r_v<bool, std::decay_t<F>&, const Args&...>
+        int connect(F&& slot) const {
             if (!initialized_ && init_ != nullptr) { init_(); initialized_ = true; }
-            slots_.insert(std::make_pair(++current_id_, slot));
+            // Don't move slots while they are being called.
+            if (emitting_) {
+                pending_.emplace_back(++current_id_, std::forward<F>(slot));
+                dirty_ = true;
+            } else 
+                slots_.emplace_back(++current_id_, std::forward<F>(slot));
             return current_id_;
         }
 
         void disconnect(int id) const {
-            slots_.erase(id);
+            if (emitting_) {
+                // Slot may be running, just mark it.
+                for (auto* v : { &slots_, &pending_ }) {
+                    auto it = std::find_if(v->begin(), v->end(), 
+                        [id](const slot& s) { return s.id == id; });
+                    if (it != v->end()) { it->id = 0; dirty_ = true; }
+                }
+            } else {
+                // Slots are sorted by id.
+                auto it = std::lower_bound(slots_.begin(), slots_.end(), id,
+                    [](const slot& s, int id) { return s.id < id; });
+                if (it != slots_.end() && it->id == id) slots_.erase(it);
+            }
         }
 
         void disconnect_all() const {
-            slots_.clear();
+            if (emitting_) {
+                for (auto& s : slots_) s.id = 0;
+                pending_.clear();
+                dirty_ = true;
+            } else
+                slots_.clear();
         }
 
-        void emit(Args... p) {
+        void emit(const Args&... p) {
+            emitting_++;
+            struct guard_s { 
+                const signal* s; 
+                ~guard_s() { if (--s->emitting_ == 0 && s->dirty_) s->compact(); }
+            } guard { this };
             // Iterate in reverse order to first emit to last connections.
-            for (auto it = slots_.rbegin(); it != slots_.rend(); ++it) {
-                if (it->second(std::forward<Args>(p)...)) break;
+            // Use index, slots may be disconnected meanwhile.
+            for (auto i = slots_.size(); i-- > 0; ) {
+                if (slots_[i].id && slots_[i](p...)) break;
             }
         }
+
+        // Emit on the event loop thread (see app::post). Safe to call 
+        // from any thread. Arguments are copied, signal must outlive it.
+        void emit_queued(Args... p);
     private:
-        mutable std::map<int, std::function<bool(Args...)>> slots_;
+        // Type erased callable. Small ones (member function bindings)
+        // live inside the slot, the rest on the heap.
+        class slot {
+        public:
+            template <typename F> slot(int id, F&& f) : id(id) {
+                typedef std::decay_t<F> fn_t;
+                if constexpr (sizeof(fn_t) <= sizeof(buf_) 
+                    && alignof(fn_t) <= alignof(void*)
+                    && std::is_nothrow_move_constructible_v<fn_t>) {
+                    ::new (buf_) fn_t(std::forward<F>(f));
+                    ops_ = &inline_ops<fn_t>;
+                } else {
+                    *reinterpret_cast<fn_t**>(buf_) = new fn_t(std::forward<F>(f));
+                    ops_ = &heap_ops<fn_t>;
+                }
+            }
+            slot(slot&& other) noexcept : id(other.id), ops_(other.ops_) {
+                ops_->move(buf_, other.buf_); other.ops_ = nullptr;
+            }
+            slot& operator=(slot&& other) noexcept {
+                if (this != &other) {
+                    if (ops_) ops_->destroy(buf_);
+                    id = other.id; ops_ = other.ops_;
+                    ops_->move(buf_, other.buf_); other.ops_ = nullptr;
+                }
+                return *this;
+            }
+            ~slot() { if (ops_) ops_->destroy(buf_); }
+            bool operator()(const Args&... p) { return ops_->call(buf_, p...); }
+            int id; // 0 when disconnected during emit.
+        private:
+            struct ops_s {
+                bool (*call)(void*, const Args&...);
+                void (*move)(void*, void*); // Move to first, destroy second.
+                void (*destroy)(void*);
+            };
+            template <typename F> static constexpr ops_s inline_ops {
+                [](void* b, const Args&... p) -> bool { return (*static_cast<F*>(b))(p...); },
+                [](void* d, void* s) { 
+                    ::new (d) F(std::move(*static_cast<F*>(s))); 
+                    static_cast<F*>(s)->~F(); 
+                },
+                [](void* b) { static_cast<F*>(b)->~F(); }
+            };
+            template <typename F> static constexpr ops_s heap_ops {
+                [](void* b, const Args&... p) -> bool { return (**static_cast<F**>(b))(p...); },
+                [](void* d, void* s) { *static_cast<F**>(d) = *static_cast<F**>(s); },
+                [](void* b) { delete *static_cast<F**>(b); }
+            };
+            alignas(void*) unsigned char buf_[4 * sizeof(void*)];
+            const ops_s* ops_;
+        };
+        typedef std::vector<slot> slot_vector;
+
+        // Drop slots disconnected during emit, add the connected ones.
+        void compact() const {
+            std::erase_if(slots_, [](const slot& s) { return s.id == 0; });
+            for (auto& s : pending_) if (s.id) slots_.push_back(std::move(s));
+            pending_.clear();
+            dirty_ = false;
+        }
+
+        mutable slot_vector slots_;
+        mutable slot_vector pending_;
+        mutable int emitting_{ 0 };
+        mutable bool dirty_{ false };
         mutable int current_id_;
         mutable bool initialized_{ false };
         std::function<void()> init_{ nullptr };
     };
 //{{END.DEC}}
 
+//{{BEGIN.DEF}}
+    template <typename... Args>
+    void signal<Args...>::emit_queued(Args... p) {
+        app::post([this, ...args = std::decay_t<Args>(p)]() mutable {
+            emit(args...);
+        });
+    }
+//{{END.DEF}}
+
 }
 
 #endif // _SIGNAL_HPP
\ No newline at end of file
@@ -0,0 +1,88 @@
+//
+// static_signal.hpp
+//
+// Slots bound at compile time. Emit is a chain of direct member
+// function calls that the compiler can inline.
+//
+//   static_signal<&main_wnd::on_paint, &main_wnd::on_overlay> painter_{this};
+//   paint.connect(painter_);
+//
+// Connected to a dynamic signal it occupies one inline slot, so the
+// whole chain costs a single indirect call. Windows also have static
+// slots for hot events, called before the signal without its loop:
+//
+//   paint_slot.bind<&main_wnd::on_paint, &main_wnd::on_overlay>(this);
+//
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+//
+// 16.10.2026   tstih
+//
+#ifndef _STATIC_SIGNAL_HPP
+#define _STATIC_SIGNAL_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    template <typename F> struct slot_traits;
+    template <typename T, typename... Args>
+    struct slot_traits<bool (T::*)(Args...)> { typedef T class_type; };
+    template <typename T, typename... Args>
+    struct slot_traits<bool (T::*)(Args...) const> { typedef const T class_type; };
+
+    template <auto First, auto... Rest>
+    class static_signal {
+    public:
+        typedef typename slot_traits<decltype(First)>::class_type class_type;
+
+        static_signal(class_type* inst) : inst_(inst) {}
+
+        // Same semantics as signal: last slot first, stop when
+        // a slot returns true.
+        template <typename... Args> bool emit(const Args&... p) const {
+            return emit_from<First, Rest...>(p...);
+        }
+
+        template <typename... Args> bool operator()(const Args&... p) const {
+            return emit_from<First, Rest...>(p...);
+        }
+
+    private:
+        template <auto S, auto... Ss, typename... Args>
+        bool emit_from(const Args&... p) const {
+            if constexpr (sizeof...(Ss) > 0)
+                if (emit_from<Ss...>(p...)) return true;
+            return (inst_->*S)(p...);
+        }
+
+        class_type* inst_;
+    };
+
+    // Static signal behind a function pointer, so that non template 
+    // code (i.e. native window) can call it.
+    template <typename... Args>
+    class static_slot {
+    public:
+        template <auto... Slots> 
+        void bind(typename static_signal<Slots...>::class_type* inst) {
+            inst_=(void*)inst;
+            fn_=[](void* i, const Args&... p) {
+                typedef typename static_signal<Slots...>::class_type class_type;
+                return static_signal<Slots...>((class_type*)i).emit(p...);
+            };
+        }
+        void unbind() { fn_=nullptr; }
+        bool bound() const { return fn_!=nullptr; }
+        // True if a slot handled it.
+        bool emit(const Args&... p) const { 
+            return fn_!=nullptr && fn_(inst_, p...); 
+        }
+    private:
+        void* inst_ {nullptr};
+        bool (*fn_)(void*, const Args&...) {nullptr};
+    };
+//{{END.DEC}}
+
+}
+
+#endif // _STATIC_SIGNAL_HPP
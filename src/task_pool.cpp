@@ -0,0 +1,123 @@
+//
+// task_pool.cpp
+// 
+// Work stealing pool implementation.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    // Static variable.
+    thread_local task_pool* task_pool::current_=nullptr;
+
+    task_pool::task_pool(int workers) {
+        if (workers<0) 
+            workers=std::max(0, (int)std::thread::hardware_concurrency()-1);
+        for (int i=0; i<=workers; i++) 
+            queues_.push_back(std::make_unique<queue_s>());
+        for (int i=0; i<workers; i++)
+            workers_.emplace_back([this, i]() { work(i); });
+    }
+
+    task_pool::~task_pool() {
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            stop_=true;
+        }
+        start_cv_.notify_all();
+        for (auto& w : workers_) w.join();
+    }
+
+    task_pool& task_pool::shared() {
+        static task_pool pool;
+        return pool;
+    }
+
+    void task_pool::run(size_t n, std::function<void(size_t)> fn) {
+        if (n==0) return;
+        // Nested, workers are busy with (or waiting for) our batch.
+        // Or no workers, then handing tasks over only costs time.
+        if (current_==this || workers_.empty()) {
+            for (size_t i=0; i<n; i++) fn(i);
+            return;
+        }
+        // One batch at a time.
+        std::lock_guard<std::mutex> run_lock(run_m_);
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            fn_=fn;
+            remaining_=n;
+            // Deal neighbouring tasks to the same queue.
+            size_t nq=queues_.size(), chunk=(n+nq-1)/nq;
+            for (size_t q=0; q<nq; q++) {
+                std::lock_guard<std::mutex> qlock(queues_[q]->m);
+                for (size_t i=q*chunk; i<std::min(n, (q+1)*chunk); i++) 
+                    queues_[q]->tasks.push_back(i);
+            }
+            batch_++;
+        }
+        start_cv_.notify_all();
+        // Help.
+        size_t task, self=queues_.size()-1;
+        while (pop(self, task)) execute(task);
+        std::unique_lock<std::mutex> lock(m_);
+        done_cv_.wait(lock, [this]() { return remaining_==0; });
+    }
+
+    bool task_pool::pop(size_t self, size_t& task) {
+        {
+            auto& q=*queues_[self];
+            std::lock_guard<std::mutex> lock(q.m);
+            if (!q.tasks.empty()) {
+                task=q.tasks.back();
+                q.tasks.pop_back();
+                return true;
+            }
+        }
+        // Steal, starting with the next queue.
+        for (size_t i=1; i<queues_.size(); i++) {
+            auto& q=*queues_[(self+i) % queues_.size()];
+            std::lock_guard<std::mutex> lock(q.m);
+            if (!q.tasks.empty()) {
+                task=q.tasks.front();
+                q.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void task_pool::execute(size_t task) {
+        task_pool* outer=current_;
+        current_=this;
+        fn_(task);
+        current_=outer;
+        if (--remaining_==0) {
+            // Lock, so that run() doesn't miss the notification.
+            std::lock_guard<std::mutex> lock(m_);
+            done_cv_.notify_all();
+        }
+    }
+
+    void task_pool::work(size_t self) {
+        uint64_t seen=0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_);
+                start_cv_.wait(lock, [&]() { return stop_ || batch_!=seen; });
+                if (stop_) return;
+                seen=batch_;
+            }
+            size_t task;
+            while (pop(self, task)) execute(task);
+        }
+    }
+//{{END.DEF}}
+
+} // namespace nice
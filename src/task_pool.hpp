@@ -0,0 +1,56 @@
+//
+// task_pool.hpp
+// 
+// Worker threads for parallel loops. Each worker owns a queue of
+// task indices, pops from its back and, when empty, steals from 
+// the front of other queues. The calling thread works too.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _TASK_POOL_HPP
+#define _TASK_POOL_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    class task_pool {
+    public:
+        // Number of workers, negative means one less than hardware 
+        // threads. With no workers run() loops on the calling thread.
+        task_pool(int workers=-1);
+        virtual ~task_pool();
+        // Call fn(i) for i in [0,n) in parallel, return when all are done.
+        // Called from within a task it runs fn serially on that thread.
+        void run(size_t n, std::function<void(size_t)> fn);
+        // Workers plus calling thread.
+        int threads() const { return (int)queues_.size(); }
+        // Pool shared by the library, created on first use.
+        static task_pool& shared();
+    private:
+        struct queue_s {
+            std::mutex m;
+            std::deque<size_t> tasks;
+        };
+        // Take task from own queue, or steal one.
+        bool pop(size_t self, size_t& task);
+        void work(size_t self);
+        void execute(size_t task);
+        std::vector<std::unique_ptr<queue_s>> queues_; // Last is caller's.
+        std::vector<std::thread> workers_;
+        std::mutex m_, run_m_;
+        std::condition_variable start_cv_, done_cv_;
+        std::function<void(size_t)> fn_;
+        uint64_t batch_ {0};
+        std::atomic<size_t> remaining_ {0};
+        bool stop_ {false};
+        // Pool whose task this thread is executing.
+        static thread_local task_pool* current_;
+    };
+//{{END.DEC}}
+
+} // namespace nice
+
+#endif // _TASK_POOL_HPP
@@ -0,0 +1,38 @@
+//
+// text_run.cpp
+// 
+// Text run cache.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    // Static variables.
+    lru_cache<text_run::key, std::shared_ptr<const text_run>, text_run::key_hash> 
+        text_run::cache_(1024*1024);
+    std::mutex text_run::mutex_;
+
+    std::shared_ptr<const text_run> text_run::get(const font& f, const std::string& text) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        key k { f.id(), text };
+        auto* cached=cache_.find(k);
+        if (cached!=nullptr) return *cached;
+        auto run=std::shared_ptr<text_run>(new text_run(f));
+        run->extent_=f.layout(text, run->quads_);
+        size_t bytes=sizeof(text_run) + text.size() + run->quads_.size() * sizeof(glyph_quad);
+        return cache_.insert(k, run, bytes);
+    }
+
+    void text_run::budget(size_t bytes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cache_.budget(bytes);
+    }
+//{{END.DEF}}
+
+} // namespace nice
@@ -0,0 +1,50 @@
+//
+// text_run.hpp
+// 
+// Laid out text. Runs are cached by text and font, so drawing an 
+// unchanged label again is a lookup and a loop over its glyphs.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _TEXT_RUN_HPP
+#define _TEXT_RUN_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    class text_run {
+    public:
+        // Run of text in font, from cache or laid out. Thread safe.
+        static std::shared_ptr<const text_run> get(const font& f, const std::string& text);
+        const std::vector<glyph_quad>& quads() const { return quads_; }
+        nice::size extent() const { return extent_; }
+        // Memory budget of run cache in bytes (default 1MB).
+        static void budget(size_t bytes);
+    private:
+        text_run(const font& f) : font_(f) {}
+        font font_; // Keeps atlas pages alive.
+        std::vector<glyph_quad> quads_;
+        nice::size extent_;
+        struct key {
+            uint64_t font;
+            std::string text;
+            bool operator==(const key& o) const { 
+                return font==o.font && text==o.text; 
+            }
+        };
+        struct key_hash {
+            size_t operator()(const key& k) const {
+                return std::hash<std::string>()(k.text) ^ std::hash<uint64_t>()(k.font);
+            }
+        };
+        static lru_cache<key, std::shared_ptr<const text_run>, key_hash> cache_;
+        static std::mutex mutex_;
+    };
+//{{END.DEC}}
+
+} // namespace nice
+
+#endif // _TEXT_RUN_HPP
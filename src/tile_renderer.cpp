@@ -0,0 +1,89 @@
+//
+// tile_renderer.cpp
+// 
+// Tile renderer implementation.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEF}}
+    int tile_renderer::tile_size(int w, int h) const {
+        if (tile_size_>0) return tile_size_;
+        int threads=pool_.threads();
+        if (threads<=1) return std::max({ w, h, 1 });
+        for (int s=256; s>64; s/=2)
+            if (((w+s-1)/s) * ((h+s-1)/s) >= 4*threads) return s;
+        return 64;
+    }
+
+    std::vector<rct> tile_renderer::render(const display_list& list, raster& target, 
+        const region& damage) {
+        int ts=tile_size(target.width(), target.height());
+        int cols=(target.width()+ts-1)/ts, rows=(target.height()+ts-1)/ts;
+        bins_.resize(cols*rows);
+        for (auto& b : bins_) b.clear();
+
+        // Paths are flattened once, not per tile.
+        list.flatten();
+
+        // Bin commands.
+        rct all { 0, 0, target.width(), target.height() };
+        for (size_t i=0; i<list.size(); i++) {
+            rct b=region::intersection(list.bounds(i), all);
+            if (region::empty(b)) continue;
+            for (int ty=b.y/ts; ty<=(b.y+b.h-1)/ts; ty++)
+                for (int tx=b.x/ts; tx<=(b.x+b.w-1)/ts; tx++)
+                    bins_[ty*cols+tx].push_back((uint32_t)i);
+        }
+
+        // Tiles to render.
+        std::vector<rct> tiles;
+        std::vector<uint32_t> which;
+        for (int ty=0; ty<rows; ty++)
+            for (int tx=0; tx<cols; tx++) {
+                rct t=region::intersection({ tx*ts, ty*ts, ts, ts }, all);
+                if (bins_[ty*cols+tx].empty()) continue;
+                if (!damage.empty() && !damage.intersects(t)) continue;
+                tiles.push_back(t);
+                which.push_back(ty*cols+tx);
+            }
+
+        // Damaged parts of tiles.
+        std::vector<region> clips(tiles.size());
+        for (size_t i=0; i<tiles.size(); i++) {
+            if (damage.empty()) 
+                clips[i].add(tiles[i]);
+            else for (auto const& d : damage.rects()) {
+                rct r=region::intersection(d, tiles[i]);
+                if (!region::empty(r)) clips[i].add(r);
+            }
+            tiles[i]=clips[i].bounds();
+        }
+
+        // Rasterize.
+        pool_.run(tiles.size(), [&](size_t i) {
+            artist a(target, clips[i], false);
+            list.replay(a, bins_[which[i]]);
+        });
+
+        // Only rendered tiles changed, so uploaded copies of target 
+        // refresh just them. Marked here, modified(rct) isn't thread 
+        // safe. More tiles than target remembers are merged.
+        if (tiles.size()<=raster::changes_kept)
+            for (auto const& t : tiles) target.modified(t);
+        else {
+            rct b=tiles.front();
+            for (auto const& t : tiles) b=region::bounds(b, t);
+            target.modified(b);
+        }
+        return tiles;
+    }
+//{{END.DEF}}
+
+} // namespace nice
@@ -0,0 +1,51 @@
+//
+// tile_renderer.hpp
+// 
+// Renders a display list into a raster in parallel. The raster is
+// split into square tiles, commands are binned into the tiles they
+// touch, and tiles are rasterized on a task pool. Each pixel is 
+// drawn by one tile, with commands in recorded order, so the result 
+// is identical to drawing the list on a single thread.
+//
+// Workers only touch pixels (raster::raw(), mipmaps and atlas pages
+// of text laid out when recorded), never the display. Rasters the 
+// list draws must not be written while it renders.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _TILE_RENDERER_HPP
+#define _TILE_RENDERER_HPP
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    class tile_renderer {
+    public:
+        // Tile size 0 picks one per render (see tile_size()).
+        tile_renderer(int tile_size=0, task_pool& pool=task_pool::shared()) 
+            : tile_size_(tile_size), pool_(pool) {}
+        // Render list to target, only tiles touching damage (empty=all).
+        // Returns rendered tiles (their damaged part), i.e. to invalidate,
+        // and marks them modified in target. Pixels are the same as when replaying the
+        // list serially.
+        std::vector<rct> render(const display_list& list, raster& target, 
+            const region& damage=region());
+        // Tile size for target of w x h. Each tile walks the edges of all
+        // paths it touches, so tiles are as large as possible (256 at
+        // most), while leaving 4 tiles per thread to balance work. 
+        // Without workers the whole target is one tile.
+        int tile_size(int w, int h) const;
+    private:
+        int tile_size_;
+        task_pool& pool_;
+        // Command indices per tile (kept to reuse memory).
+        std::vector<std::vector<uint32_t>> bins_;
+    };
+//{{END.DEC}}
+
+} // namespace nice
+
+#endif // _TILE_RENDERER_HPP
@@ -0,0 +1,72 @@
+//
+// timer_queue.cpp
+// 
+// Timer queue implementation.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#include "nice.hpp"
+
+namespace nice {
+//{{BEGIN.DEF}}
+    int timer_queue::add(
+        clock::duration interval, std::function<void()> callback, bool repeat) {
+        // Zero interval would never leave tick().
+        if (repeat) interval=std::max<clock::duration>(interval, std::chrono::milliseconds(1));
+        int id=++current_id_;
+        timers_.insert(std::make_pair(id, timer_s { interval, callback, repeat }));
+        heap_.push_back({ clock::now() + interval, id });
+        std::push_heap(heap_.begin(), heap_.end(), std::greater<deadline_s>());
+        return id;
+    }
+
+    void timer_queue::cancel(int id) {
+        timers_.erase(id);
+        // Compact when mostly garbage.
+        if (heap_.size() > 64 && heap_.size() > 2 * timers_.size()) {
+            std::erase_if(heap_, [this](const deadline_s& d) { 
+                return !timers_.contains(d.id); 
+            });
+            std::make_heap(heap_.begin(), heap_.end(), std::greater<deadline_s>());
+        }
+    }
+
+    void timer_queue::pop_cancelled() {
+        while (!heap_.empty() && !timers_.contains(heap_.front().id)) {
+            std::pop_heap(heap_.begin(), heap_.end(), std::greater<deadline_s>());
+            heap_.pop_back();
+        }
+    }
+
+    timer_queue::clock::time_point timer_queue::deadline() {
+        pop_cancelled();
+        return heap_.empty() ? clock::time_point::max() : heap_.front().due;
+    }
+
+    void timer_queue::tick(clock::time_point now) {
+        pop_cancelled();
+        while (!heap_.empty() && heap_.front().due <= now) {
+            deadline_s d=heap_.front();
+            std::pop_heap(heap_.begin(), heap_.end(), std::greater<deadline_s>());
+            heap_.pop_back();
+            auto it=timers_.find(d.id);
+            if (it==timers_.end()) continue;
+            // Callback can cancel (or add) timers, so take a copy.
+            auto callback=it->second.callback;
+            if (it->second.repeat) {
+                // Stay on the grid unless we're a whole interval late.
+                d.due += it->second.interval;
+                if (d.due <= now) d.due = now + it->second.interval;
+                heap_.push_back(d);
+                std::push_heap(heap_.begin(), heap_.end(), std::greater<deadline_s>());
+            } else
+                timers_.erase(it);
+            callback();
+            pop_cancelled();
+        }
+    }
+//{{END.DEF}}
+}
@@ -0,0 +1,56 @@
+//
+// timer_queue.hpp
+// 
+// Timers. A binary min-heap of deadlines. Cancelled timers are
+// dropped lazily when they reach the top (or on compaction). The
+// earliest deadline tells the event loop how long it may sleep.
+// 
+// (c) 2021 Tomaz Stih
+// This code is licensed under MIT license (see LICENSE.txt for details).
+// 
+// 16.10.2026   tstih
+// 
+#ifndef _TIMER_QUEUE_HPP
+#define _TIMER_QUEUE_HPP
+
+#include "includes.hpp"
+
+namespace nice {
+
+//{{BEGIN.DEC}}
+    class timer_queue {
+    public:
+        typedef std::chrono::steady_clock clock;
+        // Add timer, returns its id. Repeating timers fire at most
+        // once per millisecond (shorter intervals are clamped).
+        int add(clock::duration interval, std::function<void()> callback, bool repeat);
+        // Cancel timer. Safe to call from its callback.
+        void cancel(int id);
+        // No timers?
+        bool empty() const { return timers_.empty(); }
+        // Earliest deadline (only valid if not empty).
+        clock::time_point deadline();
+        // Call callbacks of all expired timers.
+        void tick(clock::time_point now = clock::now());
+    private:
+        struct deadline_s {
+            clock::time_point due;
+            int id;
+            bool operator>(const deadline_s& other) const { return due > other.due; }
+        };
+        struct timer_s {
+            clock::duration interval;
+            std::function<void()> callback;
+            bool repeat;
+        };
+        // Remove cancelled timers from the top of the heap.
+        void pop_cancelled();
+        std::vector<deadline_s> heap_;
+        std::unordered_map<int, timer_s> timers_;
+        int current_id_ {0};
+    };
+//{{END.DEC}}
+
+}
+
+#endif // _TIMER_QUEUE_HPP
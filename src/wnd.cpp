@@ -12,7 +12,23 @@
 
 namespace nice {
 //{{BEGIN.DEF}}
-    void wnd::repaint(void) { native()->repaint(); }
+    wnd::~wnd() { app::frames_.remove(this); }
+
+    void wnd::start_frames() { 
+        frames_=true;
+        app::frames_.add(this); 
+    }
+
+    void wnd::repaint(void) { 
+        if (!retained_) { native()->repaint(); return; }
+        // Unchanged frame makes no native calls.
+        record();
+        region damage=list_.diff(prev_);
+        for (auto const& r : damage.rects())
+            native()->invalidate(r);
+    }
+
+    void wnd::invalidate(rct r) { native()->invalidate(r); }
     
     std::string wnd::get_title() { return native()->get_title(); }
     
@@ -27,5 +43,62 @@ namespace nice {
     void wnd::set_location(pt location) { native()->set_location(location); } 
 
     rct wnd::get_paint_area() { return native()->get_paint_area(); };
+
+    bool wnd::get_double_buffered() { return native()->get_double_buffered(); }
+
+    void wnd::set_double_buffered(bool db) { native()->set_double_buffered(db); }
+
+    bool wnd::get_compress_motion() { return compress_motion_; }
+
+    void wnd::set_compress_motion(bool cm) { 
+        flush_motion();
+        compress_motion_=cm; 
+    }
+
+    bool wnd::get_retained() { return retained_; }
+
+    void wnd::set_retained(bool r) {
+        retained_=r;
+        list_.clear(); prev_.clear();
+    }
+
+    void wnd::record() {
+        std::swap(list_, prev_);
+        list_.clear();
+        recorded_area_=get_paint_area();
+        artist a(list_);
+        if (!paint_slot.emit(a)) paint.emit(a);
+    }
+
+    void wnd::paint_to(const artist& a) {
+        if (!retained_) { 
+            if (!paint_slot.emit(a)) paint.emit(a); 
+            return; 
+        }
+        // Layout may depend on size.
+        rct pa=get_paint_area();
+        if (list_.empty() || pa.w!=recorded_area_.w || pa.h!=recorded_area_.h) 
+            record();
+        list_.replay(a);
+    }
+
+    void wnd::motion(const mouse_info& mi) {
+        if (compress_motion_) {
+            // Frame clock flushes compressed moves. It runs only while
+            // there are moves, so that an idle loop doesn't wake up.
+            if (motion_.empty()) app::frames_.add(this);
+            motion_.push_back(mi);
+        } else if (!mouse_move_slot.emit(mi))
+            mouse_move.emit(mi);
+    }
+
+    void wnd::flush_motion() {
+        if (motion_.empty()) return;
+        mouse_move_batch.emit(std::span<const mouse_info>(motion_));
+        if (!mouse_move_slot.emit(motion_.back()))
+            mouse_move.emit(motion_.back());
+        motion_.clear();
+        if (!frames_) app::frames_.remove(this);
+    }
 //{{END.DEF}}
 }
\ No newline at end of file
@@ -22,8 +22,13 @@ namespace nice {
 //{{BEGIN.DEC}}
     class wnd  {
     public:
+        // Dtor.
+        virtual ~wnd();
+
         // Methods.
         void repaint(void);
+        // Add rectangle to the area that needs painting.
+        void invalidate(rct r);
 
         // Properties.
         property<std::string> title {
@@ -45,15 +50,44 @@ namespace nice {
             [this]() -> rct { return this->get_paint_area(); }
         };
 
+        // Paint into back buffer and copy it to window at the end.
+        property<bool> double_buffered {
+            [this](bool db) { this->set_double_buffered(db); },
+            [this]() -> bool {  return this->get_double_buffered(); }
+        };
+
+        // Record paint to a display list. Then repaint() only invalidates
+        // what changed since the last recording, and expose replays it.
+        property<bool> retained {
+            [this](bool r) { this->set_retained(r); },
+            [this]() -> bool {  return this->get_retained(); }
+        };
+
+        // Deliver mouse moves once per frame (see app::frame_rate): the
+        // latest to mouse_move, and all samples since last frame to 
+        // mouse_move_batch.
+        property<bool> compress_motion {
+            [this](bool cm) { this->set_compress_motion(cm); },
+            [this]() -> bool {  return this->get_compress_motion(); }
+        };
+
         // Signals.
         signal<> created;
         signal<> destroyed;
         signal<const artist&> paint;
         signal<const resized_info&> resized;
         signal<const mouse_info&> mouse_move;
+        signal<std::span<const mouse_info>> mouse_move_batch;
+        // Emitted at frame rate (see app::frame_rate) once connected.
+        signal<const frame_info&> frame { [this]() { this->start_frames(); } };
         signal<const mouse_info&> mouse_down;
         signal<const mouse_info&> mouse_up;
 
+        // Slots bound at compile time (see static_signal). Called before
+        // paint and mouse_move signals, which are skipped if they return true.
+        static_slot<const artist&> paint_slot;
+        static_slot<const mouse_info&> mouse_move_slot;
+
     protected:
         // Setters and getters.
         virtual std::string get_title();
@@ -63,9 +97,39 @@ namespace nice {
         virtual pt get_location();
         virtual void set_location(pt location);
         virtual rct get_paint_area();
+        virtual bool get_double_buffered();
+        virtual void set_double_buffered(bool db);
+        virtual bool get_compress_motion();
+        virtual void set_compress_motion(bool cm);
+        virtual bool get_retained();
+        virtual void set_retained(bool r);
+
+        // Native window delivers mouse moves through these, and frame
+        // clock flushes compressed ones.
+        friend class native_wnd;
+        friend class frame_clock;
+        void motion(const mouse_info& mi);
+        void flush_motion();
+        // ...and paints through this.
+        void paint_to(const artist& a);
+
+        // Subscribe to frame clock.
+        void start_frames();
 
         // Pimpl. Concrete window must implement this!
         virtual native_wnd* native() = 0;
+
+    private:
+        // Compressed mouse moves.
+        bool compress_motion_ {false};
+        // Frame signal connected?
+        bool frames_ {false};
+        std::vector<mouse_info> motion_;
+        // Retained mode, last and previous recording.
+        bool retained_ {false};
+        display_list list_, prev_;
+        rct recorded_area_ {0,0,0,0};
+        void record();
     };
 //{{END.DEC}}
 